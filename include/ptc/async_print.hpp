@@ -0,0 +1,403 @@
+//====================================================
+//     Metadata
+//====================================================
+/**
+ * @file async_print.hpp
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Preprocessor directives
+//====================================================
+#ifndef ASYNC_PRINT_HPP
+#define ASYNC_PRINT_HPP
+#pragma once
+
+//====================================================
+//     Headers
+//====================================================
+#include "print.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ptc
+ {
+  //====================================================
+  //     Enum classes
+  //====================================================
+
+  // overflow
+  /**
+   * @brief Enum class used to choose what happens when the message queue of an AsyncPrint object is full: the caller waits for free space (block), the new message is discarded (drop) or the oldest queued message is discarded to make room for the new one (drop_oldest).
+   *
+   */
+   enum class overflow { block, drop, drop_oldest };
+
+  //====================================================
+  //     AsyncPrint class
+  //====================================================
+  /**
+   * @brief Class used to construct an asynchronous print function. Each call is formatted by the calling thread and pushed as a whole message onto a bounded queue, which is drained by a dedicated writer thread. Each message is written with a single write, therefore the per-call atomicity of ptc::print is preserved.
+   *
+   */
+  class AsyncPrint: public Print
+   {
+    public:
+
+     //====================================================
+     //     Public constructors and destructor
+     //====================================================
+
+     // Constructor
+     /**
+      * @brief Construct a new AsyncPrint object and start its writer thread.
+      *
+      * @param os The default stream to which messages are written.
+      * @param capacity The maximum number of queued messages.
+      * @param policy The policy applied when the queue is full.
+      */
+     explicit AsyncPrint( std::ostream& os = std::cout, std::size_t capacity = 1024, overflow policy = overflow::block ):
+      os_( &os ),
+      queue_( capacity ? capacity : 1 ),
+      policy_( policy ),
+      writer_( [ this ]{ writer_loop(); } )
+      {}
+
+     // Destructor
+     /**
+      * @brief Destroy the AsyncPrint object. All the queued messages are delivered before the writer thread is joined.
+      *
+      */
+     ~AsyncPrint()
+      {
+       join();
+      }
+
+     AsyncPrint( const AsyncPrint& ) = delete;
+     AsyncPrint& operator =( const AsyncPrint& ) = delete;
+
+     //====================================================
+     //     Public getters
+     //====================================================
+
+     // getDropped
+     /**
+      * @brief Getter used to get the number of messages discarded because of a full queue.
+      *
+      * @return std::uint64_t The number of discarded messages.
+      */
+     std::uint64_t getDropped() const
+      {
+       std::lock_guard <std::mutex> lock{ queue_mutex_ };
+       return dropped_;
+      }
+
+     //====================================================
+     //     Public methods
+     //====================================================
+
+     // flush
+     /**
+      * @brief Method used to wait until all the messages pushed before this call have been written, then to flush the default stream.
+      *
+      */
+     void flush()
+      {
+       std::unique_lock <std::mutex> lock{ queue_mutex_ };
+       const std::uint64_t target = accepted_;
+       done_.wait( lock, [ this, target ]{ return completed_ >= target || ! running_; } );
+       lock.unlock();
+
+       std::lock_guard <std::mutex> stream_lock{ stream_mutex( *os_ ) };
+       os_ -> flush();
+      }
+
+     // join
+     /**
+      * @brief Method used to stop the writer thread once all the queued messages have been delivered. Messages printed after this call are written synchronously.
+      *
+      */
+     void join()
+      {
+        {
+         std::lock_guard <std::mutex> lock{ queue_mutex_ };
+         stopping_ = true;
+        }
+       not_empty_.notify_one();
+       if ( writer_.joinable() ) writer_.join();
+      }
+
+     //====================================================
+     //     Public operator () overloads
+     //====================================================
+
+     // General case
+     /**
+      * @brief Frontend implementation of the () operator overload to asynchronously print to the output stream.
+      *
+      * @tparam T Generic type of first object to be printed (or the output stream).
+      * @tparam Args Generic type of all the other objects to be printed.
+      * @param first First object to be printed (or the output stream).
+      * @param args The list of all the other objects to be printed.
+      */
+     template <class T, class... Args>
+     void operator()( T&& first, Args&&... args )
+      {
+       if constexpr ( std::is_base_of_v <std::ostream, std::remove_reference_t<T>> )
+        {
+         if constexpr( sizeof...( args ) > 0 ) push( first, std::forward<Args>( args )... );
+         else push_end( first );
+        }
+       else
+        {
+         push( *os_, std::forward<T>( first ), std::forward<Args>( args )... );
+        }
+      }
+
+     // String initialization case
+     /**
+      * @brief Frontend implementation of the () operator overload to initialize an std::string object. Strings are built synchronously, as for the Print class.
+      *
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param first The mode flag.
+      * @param args The list of all the objects to be printed.
+      * @return const std::string The whole print content in std::string format.
+      */
+     template <class... Args>
+     const std::string operator()( mode&& first, Args&&... args )
+      {
+       return Print::operator()( std::move( first ), std::forward<Args>( args )... );
+      }
+
+     // Output target cases
+     /**
+      * @brief Frontend implementation of the () operator overload to print into a caller-provided target (see ptc::to). Targets are filled synchronously, as for the Print class.
+      *
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param first The output target.
+      * @param args The list of all the objects to be printed.
+      * @return The value returned by the Print class.
+      */
+     template <class... Args>
+     std::size_t operator()( string_target&& first, Args&&... args )
+      {
+       return Print::operator()( std::move( first ), std::forward<Args>( args )... );
+      }
+
+     template <class OutputIt, class... Args>
+     OutputIt operator()( iterator_target <OutputIt>&& first, Args&&... args )
+      {
+       return Print::operator()( std::move( first ), std::forward<Args>( args )... );
+      }
+
+     template <class OutputIt, class... Args>
+     to_n_result <OutputIt> operator()( bounded_target <OutputIt>&& first, Args&&... args )
+      {
+       return Print::operator()( std::move( first ), std::forward<Args>( args )... );
+      }
+
+     #ifdef PTC_MEMORY_RESOURCE
+
+     template <class... Args>
+     std::pmr::string operator()( resource_target&& first, Args&&... args )
+      {
+       return Print::operator()( std::move( first ), std::forward<Args>( args )... );
+      }
+
+     #endif
+
+     // No arguments case
+     /**
+      * @brief Operator redefinition used to asynchronously print an empty line to the default stream.
+      *
+      */
+     void operator()()
+      {
+       push_end( *os_ );
+      }
+
+    private:
+
+     //====================================================
+     //     Private structs
+     //====================================================
+
+     // message
+     /**
+      * @brief Struct used to store a formatted message together with the stream it is directed to and its flush flag.
+      *
+      */
+     struct message
+      {
+       std::ostream* target = nullptr;
+       bool flush = false;
+       std::string data;
+      };
+
+     //====================================================
+     //     Private methods
+     //====================================================
+
+     // push
+     /**
+      * @brief Method used to format a print call in the buffer of the current thread and to enqueue it.
+      *
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param os The stream to which the message is directed.
+      * @param args The list of objects to be printed.
+      */
+     template <class... Args>
+     void push( std::ostream& os, Args&&... args )
+      {
+       const snapshot config( settings_ );
+       format_buffer::lease buf;
+       buf -> copy_format( os, config -> fast_format );
+       const bool flush_val = print_args( *config, *buf, std::forward<Args>( args )... );
+       enqueue( os, buf -> data(), flush_val );
+      }
+
+     // push_end
+     /**
+      * @brief Method used to enqueue an empty line.
+      *
+      * @param os The stream to which the message is directed.
+      */
+     void push_end( std::ostream& os )
+      {
+       const snapshot config( settings_ );
+       format_buffer::lease buf;
+       buf -> data() = config -> end;
+       enqueue( os, buf -> data(), config -> flush );
+      }
+
+     // enqueue
+     /**
+      * @brief Method used to move a formatted message into the queue, applying the overflow policy if the queue is full. The message string is swapped with the one stored in the queue slot, so that string capacities are recycled and no allocation is needed in the steady state.
+      *
+      * @param os The stream to which the message is directed.
+      * @param data The formatted message.
+      * @param flush_val If true, the stream is flushed after the message is written.
+      */
+     void enqueue( std::ostream& os, std::string& data, bool flush_val )
+      {
+       std::unique_lock <std::mutex> lock{ queue_mutex_ };
+       if ( size_ == queue_.size() && ! stopping_ )
+        {
+         switch( policy_ )
+          {
+           case overflow::block:
+            {
+             not_full_.wait( lock, [ this ]{ return size_ < queue_.size() || stopping_; } );
+             break;
+            }
+           case overflow::drop:
+            {
+             ++dropped_;
+             return;
+            }
+           case overflow::drop_oldest:
+            {
+             head_ = ( head_ + 1 ) % queue_.size();
+             --size_;
+             ++dropped_;
+             ++completed_;
+             break;
+            }
+          }
+        }
+
+       // Writing synchronously once the writer thread has been stopped
+       if ( stopping_ )
+        {
+         done_.wait( lock, [ this ]{ return completed_ >= accepted_ || ! running_; } );
+         lock.unlock();
+         std::lock_guard <std::mutex> stream_lock{ stream_mutex( os ) };
+         os.write( data.data(), static_cast <std::streamsize> ( data.size() ) );
+         if ( flush_val ) os.flush();
+         return;
+        }
+
+       auto& slot = queue_[ ( head_ + size_ ) % queue_.size() ];
+       slot.target = &os;
+       slot.flush = flush_val;
+       slot.data.swap( data );
+       ++size_;
+       ++accepted_;
+       lock.unlock();
+       not_empty_.notify_one();
+      }
+
+     // writer_loop
+     /**
+      * @brief Method executed by the writer thread. It moves all the queued messages into a local batch and writes them, each one with a single write to its stream.
+      *
+      */
+     void writer_loop()
+      {
+       std::vector <message> batch;
+       while ( true )
+        {
+         std::unique_lock <std::mutex> lock{ queue_mutex_ };
+         not_empty_.wait( lock, [ this ]{ return size_ > 0 || stopping_; } );
+         if ( size_ == 0 && stopping_ ) break;
+
+         // Taking all the queued messages
+         if ( batch.size() < size_ ) batch.resize( size_ );
+         const std::size_t n_messages = size_;
+         for ( std::size_t i = 0; i < n_messages; ++i )
+          {
+           auto& slot = queue_[ head_ ];
+           batch[ i ].target = slot.target;
+           batch[ i ].flush = slot.flush;
+           batch[ i ].data.swap( slot.data );
+           head_ = ( head_ + 1 ) % queue_.size();
+          }
+         size_ = 0;
+         lock.unlock();
+         not_full_.notify_all();
+
+         // Writing the messages
+         for ( std::size_t i = 0; i < n_messages; ++i )
+          {
+           std::ostream& os = *batch[ i ].target;
+           std::lock_guard <std::mutex> stream_lock{ stream_mutex( os ) };
+           os.write( batch[ i ].data.data(), static_cast <std::streamsize> ( batch[ i ].data.size() ) );
+           if ( batch[ i ].flush && ( i + 1 == n_messages || batch[ i + 1 ].target != &os || ! batch[ i + 1 ].flush ) ) os.flush();
+          }
+
+         lock.lock();
+         completed_ += n_messages;
+         lock.unlock();
+         done_.notify_all();
+        }
+
+       std::lock_guard <std::mutex> lock{ queue_mutex_ };
+       running_ = false;
+       done_.notify_all();
+      }
+
+     //====================================================
+     //     Private attributes
+     //====================================================
+     std::ostream* os_;
+     std::vector <message> queue_;
+     overflow policy_;
+     std::size_t head_ = 0, size_ = 0;
+     std::uint64_t accepted_ = 0, completed_ = 0, dropped_ = 0;
+     bool stopping_ = false, running_ = true;
+     mutable std::mutex queue_mutex_;
+     std::condition_variable not_empty_, not_full_, done_;
+     std::thread writer_;
+   }; // end of AsyncPrint class
+ } // end of namespace ptc
+
+#endif
@@ -0,0 +1,734 @@
+//====================================================
+//     Metadata
+//====================================================
+/**
+ * @file basic_print.hpp
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Preprocessor directives
+//====================================================
+#ifndef BASIC_PRINT_HPP
+#define BASIC_PRINT_HPP
+#pragma once
+
+//====================================================
+//     Headers
+//====================================================
+#include "print.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ptc
+ {
+  //====================================================
+  //     Helper tools
+  //====================================================
+
+  // is_char_string
+  /**
+   * @brief Struct used to define a type trait for the strings of a given character type, which are appended without any conversion.
+   *
+   * @tparam T The type to be checked.
+   * @tparam CharT The character type.
+   */
+  template <class T, class CharT>
+  struct is_char_string: std::bool_constant< std::is_same_v <T, const CharT*> || std::is_same_v <T, CharT*> || std::is_same_v <T, std::basic_string_view <CharT>>> {};
+
+  template <class CharT, class Traits, class Alloc>
+  struct is_char_string <std::basic_string <CharT, Traits, Alloc>, CharT>: std::true_type {};
+
+  template <class T, class CharT>
+  inline constexpr bool is_char_string_v = is_char_string <std::decay_t<T>, CharT>::value;
+
+  // utf8_append
+  /**
+   * @brief Function used to append an UTF-8 string to a string of another character type. Runs of ASCII characters are widened 8 bytes at a time without being decoded. The output is UTF-16 for 2 bytes characters (char16_t and, on some platforms, wchar_t), UTF-32 for 4 bytes characters and it is copied unchanged for char8_t. Invalid sequences are replaced by U+FFFD.
+   *
+   * @tparam CharT The character type of the output string.
+   * @param out The output string.
+   * @param in The UTF-8 string.
+   */
+  template <class CharT>
+  void utf8_append( std::basic_string <CharT>& out, std::string_view in )
+   {
+    #ifdef __cpp_char8_t
+     if constexpr( std::is_same_v <CharT, char8_t> )
+      {
+       out.append( reinterpret_cast <const char8_t*> ( in.data() ), in.size() );
+       return;
+      }
+    #endif
+
+    // Each byte is converted into one code unit at most
+    const std::size_t old_size = out.size();
+    out.resize( old_size + in.size() );
+    CharT* dst = out.data() + old_size;
+    const unsigned char* src = reinterpret_cast <const unsigned char*> ( in.data() );
+    const unsigned char* const last = src + in.size();
+    while ( src != last )
+     {
+      // ASCII characters
+      for ( std::uint64_t word; last - src >= 8; src += 8, dst += 8 )
+       {
+        std::memcpy( &word, src, 8 );
+        if ( word & 0x8080808080808080ull ) break;
+        for ( std::size_t i = 0; i < 8; ++i ) dst[ i ] = static_cast <CharT> ( src[ i ] );
+       }
+      if ( src == last ) break;
+      if ( *src < 0x80 )
+       {
+        *dst++ = static_cast <CharT> ( *src++ );
+        continue;
+       }
+
+      // Multi-byte sequences
+      const std::size_t length = *src >= 0xF0 ? 4 : *src >= 0xE0 ? 3 : *src >= 0xC0 ? 2 : 0;
+      char32_t code = *src & ( 0x7F >> length );
+      bool valid = length > 0 && length <= 4 && static_cast <std::size_t> ( last - src ) >= length;
+      for ( std::size_t i = 1; valid && i < length; ++i )
+       {
+        valid = ( src[ i ] & 0xC0 ) == 0x80;
+        code = ( code << 6 ) | ( src[ i ] & 0x3F );
+       }
+      constexpr char32_t min_code[ 5 ] = { 0, 0, 0x80, 0x800, 0x10000 };
+      valid = valid && *src < 0xF8 && code >= min_code[ length ] && code <= 0x10FFFF && ( code < 0xD800 || code > 0xDFFF );
+      if ( ! valid )
+       {
+        code = 0xFFFD;
+        src += 1;
+       }
+      else src += length;
+      if constexpr( sizeof( CharT ) == 2 )
+       {
+        if ( code >= 0x10000 )
+         {
+          code -= 0x10000;
+          *dst++ = static_cast <CharT> ( 0xD800 + ( code >> 10 ) );
+          *dst++ = static_cast <CharT> ( 0xDC00 + ( code & 0x3FF ) );
+          continue;
+         }
+       }
+      *dst++ = static_cast <CharT> ( code );
+     }
+    out.resize( static_cast <std::size_t> ( dst - out.data() ) );
+   }
+
+  //====================================================
+  //     BasicPrint class
+  //====================================================
+  /**
+   * @brief Class used to construct a print function which writes to a stream of another character type (ex: std::wostream). Strings and characters of the same type are appended without any conversion, narrow strings are treated as UTF-8 and transcoded, while all the other objects are formatted as in the Print class and then transcoded. Separators and end are stored already transcoded. Ex: "ptc::wprint( L"Hello", "world", 123 )".
+   *
+   * @tparam CharT The character type of the output (wchar_t, char8_t, char16_t or char32_t).
+   */
+  template <class CharT>
+  class BasicPrint
+   {
+    static_assert( ! std::is_same_v <CharT, char>, "Use ptc::Print for narrow output." );
+
+    public:
+
+     //====================================================
+     //     Public types
+     //====================================================
+     using char_type = CharT;
+     using string_type = std::basic_string <CharT>;
+     using string_view_type = std::basic_string_view <CharT>;
+     using ostream_type = std::basic_ostream <CharT>;
+
+     //====================================================
+     //     Public setters
+     //====================================================
+
+     // setEnd
+     /**
+      * @brief Setter used to set the value of the "end" variable.
+      *
+      * @param end_val The value of the "end" variable.
+      */
+     void setEnd( string_view_type end_val )
+      {
+       settings_.update( [ end_val ]( settings& config ){ config.setEnd( string_type( end_val ) ); } );
+      }
+
+     // setEnd
+     /**
+      * @brief Setter used to set the value of the "end" variable from an UTF-8 string, which is transcoded only once.
+      *
+      * @param end_val The value of the "end" variable.
+      */
+     void setEnd( std::string_view end_val )
+      {
+       string_type value;
+       utf8_append( value, end_val );
+       settings_.update( [ &value ]( settings& config ){ config.setEnd( value ); } );
+      }
+
+     // setSep
+     /**
+      * @brief Setter used to set the value of the "sep" variable.
+      *
+      * @param sep_val The value of the "sep" variable.
+      */
+     void setSep( string_view_type sep_val )
+      {
+       settings_.update( [ sep_val ]( settings& config ){ config.sep = sep_val; } );
+      }
+
+     // setSep
+     /**
+      * @brief Setter used to set the value of the "sep" variable from an UTF-8 string, which is transcoded only once.
+      *
+      * @param sep_val The value of the "sep" variable.
+      */
+     void setSep( std::string_view sep_val )
+      {
+       string_type value;
+       utf8_append( value, sep_val );
+       settings_.update( [ &value ]( settings& config ){ config.sep = value; } );
+      }
+
+     // setFlush
+     /**
+      * @brief Setter used to set the value of the "flush" variable.
+      *
+      * @param flush_val The value of the "flush" variable.
+      */
+     void setFlush( bool flush_val )
+      {
+       settings_.update( [ flush_val ]( settings& config ){ config.flush = flush_val; } );
+      }
+
+     // setFastFormatting
+     /**
+      * @brief Setter used to enable or disable the fast formatting of the objects which are not strings (see Print::setFastFormatting).
+      *
+      * @param fast_val The value of the fast formatting flag.
+      */
+     void setFastFormatting( bool fast_val )
+      {
+       settings_.update( [ fast_val ]( settings& config ){ config.fast_format = fast_val; } );
+      }
+
+     // setMaxItems
+     /**
+      * @brief Setter used to set the maximum number of elements printed for each container (see Print::setMaxItems).
+      *
+      * @param items_val The maximum number of elements, 0 for no limit.
+      */
+     void setMaxItems( std::size_t items_val )
+      {
+       settings_.update( [ items_val ]( settings& config ){ config.max_items = items_val; } );
+      }
+
+     // setMaxDepth
+     /**
+      * @brief Setter used to set the maximum number of nested container levels printed (see Print::setMaxDepth).
+      *
+      * @param depth_val The maximum number of levels, 0 for no limit.
+      */
+     void setMaxDepth( std::size_t depth_val )
+      {
+       settings_.update( [ depth_val ]( settings& config ){ config.max_depth = depth_val; } );
+      }
+
+     //====================================================
+     //     Public getters
+     //====================================================
+
+     // getEnd
+     /**
+      * @brief Getter used to get the value of the "end" variable.
+      *
+      * @return string_type The value of the "end" variable.
+      */
+     string_type getEnd() const
+      {
+       return snapshot( settings_ ) -> end;
+      }
+
+     // getSep
+     /**
+      * @brief Getter used to get the value of the "sep" variable.
+      *
+      * @return string_type The value of the "sep" variable.
+      */
+     string_type getSep() const
+      {
+       return snapshot( settings_ ) -> sep;
+      }
+
+     // getFlush
+     /**
+      * @brief Getter used to get the value of the "flush" variable.
+      *
+      * @return bool The value of the "flush" variable.
+      */
+     bool getFlush() const
+      {
+       return snapshot( settings_ ) -> flush;
+      }
+
+     // getFastFormatting
+     /**
+      * @brief Getter used to get the value of the fast formatting flag.
+      *
+      * @return bool The value of the fast formatting flag.
+      */
+     bool getFastFormatting() const
+      {
+       return snapshot( settings_ ) -> fast_format;
+      }
+
+     // getMaxItems
+     /**
+      * @brief Getter used to get the maximum number of elements printed for each container.
+      *
+      * @return std::size_t The maximum number of elements, 0 if there is no limit.
+      */
+     std::size_t getMaxItems() const
+      {
+       return snapshot( settings_ ) -> max_items;
+      }
+
+     // getMaxDepth
+     /**
+      * @brief Getter used to get the maximum number of nested container levels printed.
+      *
+      * @return std::size_t The maximum number of levels, 0 if there is no limit.
+      */
+     std::size_t getMaxDepth() const
+      {
+       return snapshot( settings_ ) -> max_depth;
+      }
+
+     //====================================================
+     //     Public operators
+     //====================================================
+
+     // General case
+     /**
+      * @brief Frontend implementation of the () operator overload to print to the output stream. If the first argument is not a stream of the same character type, std::wcout is used (wchar_t only).
+      *
+      * @tparam T Generic type of first object to be printed (or the output stream).
+      * @tparam Args Generic type of all the other objects to be printed.
+      * @param first First object to be printed (or the output stream).
+      * @param args The list of all the other objects to be printed.
+      */
+     template <class T, class... Args>
+     void operator()( T&& first, Args&&... args ) const
+      {
+       if constexpr ( std::is_base_of_v <ostream_type, std::remove_reference_t<T>> )
+        {
+         print_backend( first, std::forward<Args>( args )... );
+        }
+       else
+        {
+         print_backend( default_stream(), std::forward<T>( first ), std::forward<Args>( args )... );
+        }
+      }
+
+     // String initialization case
+     /**
+      * @brief Frontend implementation of the () operator overload to initialize a string of the same character type.
+      *
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param first The mode flag.
+      * @param args The list of all the objects to be printed.
+      * @return const string_type The whole print content.
+      */
+     template <class... Args>
+     const string_type operator()( mode&&, Args&&... args ) const
+      {
+       if constexpr( sizeof...( args ) > 0 )
+        {
+         const snapshot config( settings_ );
+         buffer_lease buf;
+         format_call( *buf, *config, std::forward<Args>( args )... );
+         return *buf;
+        }
+       return string_type();
+      }
+
+     // No arguments case
+     /**
+      * @brief Operator redefinition used to print an empty line.
+      *
+      * @param os The stream in which you want to print the output.
+      */
+     void operator()( ostream_type& os ) const
+      {
+       const snapshot config( settings_ );
+       std::lock_guard <std::mutex> lock{ Print::stream_mutex( os ) };
+       os.write( config -> end.data(), static_cast <std::streamsize> ( config -> end.size() ) );
+       if ( config -> flush ) os.flush();
+      }
+
+     // No arguments case
+     /**
+      * @brief Operator redefinition used to print an empty line to std::wcout (wchar_t only).
+      *
+      */
+     void operator()() const
+      {
+       ( *this )( default_stream() );
+      }
+
+    private:
+
+     //====================================================
+     //     Private structs
+     //====================================================
+
+     // settings
+     /**
+      * @brief Struct used to store an immutable snapshot of the configuration. Separators are stored already transcoded, together with the end followed by the ANSI reset sequence.
+      *
+      */
+     struct settings
+      {
+       settings()
+        {
+         setEnd( string_type( 1, CharT( '\n' ) ) );
+        }
+
+       void setEnd( string_type end_val )
+        {
+         end = std::move( end_val );
+         end_reset = end;
+         end_reset.append( reset_ANSI );
+        }
+
+       string_type end, sep = string_type( 1, CharT( ' ' ) ), end_reset;
+       bool flush = false, fast_format = true;
+       std::size_t max_items = 0, max_depth = 0;
+      };
+
+     using snapshot = typename config_cell <settings>::snapshot;
+
+     // call_config
+     /**
+      * @brief Struct used to store the configuration of a single print call. Separators overridden by call options are transcoded into the storage of the call.
+      *
+      */
+     struct call_config
+      {
+       string_view_type sep, end, end_reset;
+       bool flush, fast_format;
+       std::size_t max_items, max_depth;
+       string_type sep_storage, end_storage;
+      };
+
+     // buffer_lease
+     /**
+      * @brief Class used to borrow the output buffer of the current thread for the duration of a print call. In case of nested print calls a temporary buffer is used instead.
+      *
+      */
+     class buffer_lease
+      {
+       public:
+        buffer_lease()
+         {
+          thread_local thread_buffer buffer;
+          if ( ! buffer.in_use ) buffer_ = &buffer;
+          else buffer_ = &local_.emplace();
+          buffer_ -> in_use = true;
+          buffer_ -> data.clear();
+         }
+
+        ~buffer_lease()
+         {
+          buffer_ -> in_use = false;
+          if ( buffer_ -> data.capacity() * sizeof( CharT ) > max_kept_capacity ) string_type().swap( buffer_ -> data );
+         }
+
+        buffer_lease( const buffer_lease& ) = delete;
+        buffer_lease& operator =( const buffer_lease& ) = delete;
+
+        string_type& operator *() const { return buffer_ -> data; }
+        string_type* operator ->() const { return &buffer_ -> data; }
+
+       private:
+        struct thread_buffer
+         {
+          string_type data;
+          bool in_use = false;
+         };
+
+        static constexpr std::size_t max_kept_capacity = 1 << 20;
+        std::optional <thread_buffer> local_;
+        thread_buffer* buffer_;
+      };
+
+     //====================================================
+     //     Private methods
+     //====================================================
+
+     // default_stream
+     /**
+      * @brief Method used to get the default output stream, which exists only for wchar_t.
+      *
+      * @return ostream_type& The default output stream.
+      */
+     static ostream_type& default_stream()
+      {
+       static_assert( std::is_same_v <CharT, wchar_t>, "There is no default output stream for this character type, pass it as first argument." );
+       return std::wcout;
+      }
+
+     // print_backend
+     /**
+      * @brief Backend implementation of the () operator overloads to print to the output stream. The whole call is formatted into the buffer of the current thread without holding any lock, then it is committed with a single write.
+      *
+      * @tparam T_os The type of the output stream object.
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param os The output stream object.
+      * @param args The list of objects to be printed.
+      */
+     template <class T_os, class... Args>
+     void print_backend( T_os& os, Args&&... args ) const
+      {
+       const snapshot config( settings_ );
+       buffer_lease buf;
+       const bool flush_val = format_call( *buf, *config, std::forward<Args>( args )... );
+
+       std::lock_guard <std::mutex> lock{ Print::stream_mutex( os ) };
+       os.write( buf -> data(), static_cast <std::streamsize> ( buf -> size() ) );
+       if ( flush_val ) os.flush();
+      }
+
+     // format_call
+     /**
+      * @brief Method used to apply the call options (ex: ptc::sep) of a print call and to write all the other arguments into the output buffer.
+      *
+      * @tparam Args Generic type of all the arguments.
+      * @param out The output buffer.
+      * @param defaults The configuration snapshot of the call.
+      * @param args The list of arguments.
+      * @return bool True if the stream must be flushed after the call.
+      */
+     template <class... Args>
+     static bool format_call( string_type& out, const settings& defaults, Args&&... args )
+      {
+       call_config config{ defaults.sep, defaults.end, defaults.end_reset, defaults.flush, defaults.fast_format, defaults.max_items, defaults.max_depth, {}, {} };
+       if constexpr( ( is_option_v<Args> || ... ) )
+        {
+         ( apply_option( args, config ), ... );
+         format_objects( out, config, typename object_indices <0, std::index_sequence<>, Args...>::type{}, std::forward_as_tuple( std::forward<Args>( args )... ) );
+        }
+       else if constexpr( sizeof...( args ) > 0 ) format_args( out, config, std::forward<Args>( args )... );
+       else out.append( config.end );
+       return config.flush;
+      }
+
+     // apply_option
+     /**
+      * @brief Method used to apply a call option. Separators are transcoded from UTF-8. Other arguments are ignored.
+      *
+      * @tparam T The type of the argument.
+      * @param arg The argument.
+      * @param config The configuration of the call.
+      */
+     template <class T>
+     static void apply_option( const T& arg, call_config& config )
+      {
+       if constexpr( std::is_same_v <T, sep_option> )
+        {
+         config.sep_storage.clear();
+         utf8_append( config.sep_storage, arg.value );
+         config.sep = config.sep_storage;
+        }
+       else if constexpr( std::is_same_v <T, end_option> )
+        {
+         config.end_storage.clear();
+         utf8_append( config.end_storage, arg.value );
+         config.end = config.end_storage;
+         config.end_reset = {};
+        }
+       else if constexpr( std::is_same_v <T, flush_option> ) config.flush = true;
+      }
+
+     // format_objects
+     /**
+      * @brief Method used to write the arguments of a print call which are not call options.
+      *
+      * @tparam Is The indices of the arguments which are not call options.
+      * @tparam Tuple The type of the tuple of arguments.
+      * @param out The output buffer.
+      * @param config The configuration of the call.
+      * @param args The tuple of arguments.
+      */
+     template <std::size_t... Is, class Tuple>
+     static void format_objects( string_type& out, const call_config& config, std::index_sequence<Is...>, Tuple&& args )
+      {
+       if constexpr( sizeof...( Is ) > 0 ) format_args( out, config, std::get<Is>( std::move( args ) )... );
+       else out.append( config.end );
+      }
+
+     // format_args
+     /**
+      * @brief Method used to write all the arguments, separators, end and ANSI reset sequence of a print call into the output buffer, with the same rules of the Print class. The narrow format buffer is borrowed only if some arguments need to be formatted.
+      *
+      * @tparam T Generic type of first object to be printed.
+      * @tparam Args Generic type of all the other objects to be printed.
+      * @param out The output buffer.
+      * @param config The configuration of the call.
+      * @param first First printed object.
+      * @param args The list of objects to be printed.
+      */
+     template <class T, class... Args>
+     static void format_args( string_type& out, const call_config& config, T&& first, Args&&... args )
+      {
+       // Printing all the arguments
+       std::optional <format_buffer::lease> buf;
+       if constexpr( ( is_formatted_v<T> || ... || is_formatted_v<Args> ) )
+        {
+         buf.emplace();
+         ( *buf ) -> setFast( config.fast_format );
+         ( *buf ) -> setLimits( config.max_items, config.max_depth );
+        }
+       write( out, buf, first );
+       if constexpr( sizeof...( args ) > 0 )
+        {
+         if ( is_null_str( first ) || is_escape( first, ANSI::first ) ) ( ( write( out, buf, args ), out.append( config.sep ) ), ...);
+         else ( ( out.append( config.sep ), write( out, buf, args ) ), ...);
+        }
+
+       // Printing the end and resetting the stream from ANSI escape sequences
+       const bool reset = is_escape( first, ANSI::generic ) || ( is_escape( args, ANSI::generic ) || ... );
+       if ( ! reset ) out.append( config.end );
+       else if ( ! config.end_reset.empty() ) out.append( config.end_reset );
+       else
+        {
+         out.append( config.end );
+         out.append( reset_ANSI );
+        }
+      }
+
+     // write
+     /**
+      * @brief Method used to write an object into the output buffer.
+      *
+      * @tparam T The type of the object.
+      * @param out The output buffer.
+      * @param buf The narrow format buffer, used for the objects which are not strings.
+      * @param x The object to be written.
+      */
+     template <class T>
+     static void write( string_type& out, std::optional <format_buffer::lease>& buf, const T& x )
+      {
+       if constexpr( is_char_string_v <T, CharT> ) out.append( view( x ) );
+       else if constexpr( std::is_same_v <T, CharT> ) out.push_back( x );
+       else if constexpr( is_string_like_v <std::decay_t<T>> ) utf8_append( out, view( x ) );
+       else if constexpr( is_style_v <T> ) utf8_append( out, x.code );
+       else
+        {
+         ( *buf ) -> data().clear();
+         ( *buf ) -> write( x );
+         utf8_append( out, ( *buf ) -> data() );
+        }
+      }
+
+     // view
+     /**
+      * @brief Method used to get a view of a string of any character type. Null pointers are empty strings.
+      *
+      * @tparam T The type of the string.
+      * @param str The string.
+      * @return auto The view of the string.
+      */
+     template <class T>
+     static auto view( const T& str )
+      {
+       using char_t = std::remove_cv_t <std::remove_pointer_t <std::decay_t<T>>>;
+       if constexpr( std::is_pointer_v <std::decay_t<T>> )
+        {
+         const char_t* data = str;
+         return data ? std::basic_string_view <char_t>( data ) : std::basic_string_view <char_t>();
+        }
+       else return std::basic_string_view <typename T::value_type>( str );
+      }
+
+     // is_escape
+     /**
+      * @brief Method used to check if an argument is an ANSI escape sequence. A ptc::style is always an escape sequence, while strings are checked only at their first character.
+      *
+      * @tparam T The type of the argument.
+      * @param x The argument.
+      * @param flag If flag = ANSI::first the argument must be a single escape sequence, otherwise, if flag = ANSI::generic, it must start with an escape sequence.
+      * @return true If the argument is an ANSI escape sequence.
+      * @return false Otherwise.
+      */
+     template <class T>
+     static bool is_escape( const T& x, ANSI flag )
+      {
+       if constexpr( is_style_v <T> ) return true;
+       else if constexpr( is_char_string_v <T, CharT> || is_string_like_v <std::decay_t<T>> )
+        {
+         const auto str = view( x );
+         if ( str.empty() || str[ 0 ] != '\033' ) return false;
+         return flag == ANSI::generic || str.size() < 7;
+        }
+       return false;
+      }
+
+     // is_null_str
+     /**
+      * @brief Method used to check if an argument is an empty string.
+      *
+      * @tparam T The type of the argument.
+      * @param x The argument.
+      * @return true If the argument is an empty string.
+      * @return false Otherwise.
+      */
+     template <class T>
+     static bool is_null_str( const T& x )
+      {
+       if constexpr( is_char_string_v <T, CharT> || is_string_like_v <std::decay_t<T>> ) return view( x ).empty();
+       return false;
+      }
+
+     //====================================================
+     //     Private constants
+     //====================================================
+     template <class T>
+     static constexpr bool is_formatted_v = ! is_char_string_v <T, CharT> && ! std::is_same_v <std::decay_t<T>, CharT> && ! is_string_like_v <std::decay_t<T>> && ! is_style_v <std::decay_t<T>> && ! is_option_v <T>;
+
+     static constexpr CharT reset_ANSI[] = { CharT( '\033' ), CharT( '[' ), CharT( '0' ), CharT( 'm' ), CharT( '\0' ) };
+
+     //====================================================
+     //     Private attributes
+     //====================================================
+     config_cell <settings> settings_;
+   }; // end of BasicPrint class
+
+  //====================================================
+  //     Other steps
+  //====================================================
+
+  // Aliases
+  using WPrint = BasicPrint <wchar_t>;
+  using U16Print = BasicPrint <char16_t>;
+  using U32Print = BasicPrint <char32_t>;
+  #ifdef __cpp_char8_t
+   using U8Print = BasicPrint <char8_t>;
+  #endif
+
+  // wprint function initialization
+  inline WPrint wprint;
+ } // end of namespace ptc
+
+#endif
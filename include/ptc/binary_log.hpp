@@ -0,0 +1,719 @@
+//====================================================
+//     Metadata
+//====================================================
+/**
+ * @file binary_log.hpp
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Preprocessor directives
+//====================================================
+#ifndef BINARY_LOG_HPP
+#define BINARY_LOG_HPP
+#pragma once
+
+//====================================================
+//     Headers
+//====================================================
+#include "print.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ptc
+ {
+  //====================================================
+  //     Enum classes
+  //====================================================
+
+  // log_type
+  /**
+   * @brief Enum class used to encode the type of each argument of a binary log record. "string" arguments follow the ANSI escape and empty string rules of the print function, "text" arguments are other objects already formatted by the calling thread.
+   *
+   */
+   enum class log_type: std::uint8_t { i8 = 1, i16, i32, i64, u8, u16, u32, u64, f32, f64, character, boolean, string, text };
+
+  //====================================================
+  //     BinaryLog class
+  //====================================================
+  /**
+   * @brief Class used to log print calls in a compact binary format, deferring their formatting. The calling thread only copies the raw argument values, together with the identifier of their type signature, into its own staging buffer; a background thread moves the staged records into the log file. Log files are rendered to text with the ptc::decode_log function (or with the "ptc_decode" tool), using the separator and the end of the print object given at construction. An existing log file is never truncated: the new records are appended after a run marker, which carries the separator and the end of the new run. Ex: "ptc::BinaryLog log( "service.bin" ); log( "Testing", 123, "print", '!' );".
+   *
+   */
+  class BinaryLog
+   {
+    public:
+
+     //====================================================
+     //     Public constructors and destructor
+     //====================================================
+
+     // Constructor
+     /**
+      * @brief Construct a new BinaryLog object, opening the log file in append mode and starting its writer thread. The header is written only if the file is empty, otherwise the file must already contain a binary log with the same byte order and a run marker is written instead.
+      *
+      * @param path The path of the log file.
+      * @param config The print object whose separator and end are used to render the log.
+      * @param capacity The size of the staging buffer of each thread.
+      */
+     explicit BinaryLog( const std::string& path, const Print& config = print, std::size_t capacity = std::size_t( 1 ) << 20 ):
+      file_( std::fopen( path.c_str(), "a+b" ) ),
+      capacity_( capacity ),
+      id_( next_id().fetch_add( 1 ) )
+      {
+       if ( ! file_ ) throw std::system_error( errno, std::generic_category(), "ptc::BinaryLog cannot open " + path );
+
+       // Writing the header, or a run marker if the file already contains a log
+       std::uint32_t byte_order = 0x01020304;
+       std::fseek( file_, 0, SEEK_END );
+       if ( std::ftell( file_ ) == 0 )
+        {
+         std::fwrite( magic, 1, sizeof( magic ), file_ );
+         std::fwrite( &byte_order, sizeof( byte_order ), 1, file_ );
+        }
+       else
+        {
+         char header[ sizeof( magic ) ];
+         std::rewind( file_ );
+         if ( std::fread( header, 1, sizeof( header ), file_ ) != sizeof( header ) || std::memcmp( header, magic, sizeof( magic ) ) != 0 ||
+              std::fread( &byte_order, sizeof( byte_order ), 1, file_ ) != 1 || byte_order != 0x01020304 )
+          {
+           std::fclose( file_ );
+           throw std::system_error( std::make_error_code( std::errc::invalid_argument ), "ptc::BinaryLog cannot append to " + path + ", which is not a binary log of this machine" );
+          }
+         const std::uint32_t tag = run_tag;
+         std::fseek( file_, 0, SEEK_END );
+         std::fwrite( &tag, sizeof( tag ), 1, file_ );
+        }
+       for ( const std::string& str: { config.getSep(), config.getEnd() } )
+        {
+         const auto size = static_cast <std::uint32_t> ( str.size() );
+         std::fwrite( &size, sizeof( size ), 1, file_ );
+         std::fwrite( str.data(), 1, str.size(), file_ );
+        }
+
+       writer_ = std::thread( [ this ]{ writer_loop(); } );
+      }
+
+     // Destructor
+     /**
+      * @brief Destroy the BinaryLog object, writing all the staged records. The object must not be used by other threads anymore.
+      *
+      */
+     ~BinaryLog()
+      {
+        {
+         std::lock_guard <std::mutex> lock{ stop_mutex_ };
+         stopping_ = true;
+        }
+       stop_.notify_one();
+       writer_.join();
+       flush();
+
+       std::lock_guard <std::mutex> lock{ stagings_mutex_ };
+       for ( auto& st: stagings_ ) st -> closed.store( true );
+       std::fclose( file_ );
+      }
+
+     BinaryLog( const BinaryLog& ) = delete;
+     BinaryLog& operator =( const BinaryLog& ) = delete;
+
+     //====================================================
+     //     Public getters
+     //====================================================
+
+     // getError
+     /**
+      * @brief Getter used to get the last error occurred while writing the log file.
+      *
+      * @return std::error_code The last error, or an empty error code.
+      */
+     std::error_code getError() const
+      {
+       return { error_.load( std::memory_order_relaxed ), std::generic_category() };
+      }
+
+     // getDropped
+     /**
+      * @brief Getter used to get the number of records discarded because they are larger than the staging buffer.
+      *
+      * @return std::uint64_t The number of discarded records.
+      */
+     std::uint64_t getDropped() const
+      {
+       return dropped_.load( std::memory_order_relaxed );
+      }
+
+     //====================================================
+     //     Public operator () overloads
+     //====================================================
+
+     // General case
+     /**
+      * @brief Operator used to log a print call. Integers, floating-point numbers, characters, booleans and strings are copied in binary form; all the other objects (ex: containers) are formatted by the calling thread, as in the print function.
+      *
+      * @tparam Args Generic type of all the objects to be logged.
+      * @param args The list of objects to be logged.
+      */
+     template <class... Args>
+     void operator()( Args&&... args )
+      {
+       static_assert( ! ( is_option_v<Args> || ... ), "Call options are not supported by ptc::BinaryLog." );
+       record( loggable( args )... );
+      }
+
+     //====================================================
+     //     Public methods
+     //====================================================
+
+     // flush
+     /**
+      * @brief Method used to move all the staged records into the log file and to flush it.
+      *
+      */
+     void flush()
+      {
+       std::lock_guard <std::mutex> lock{ drain_mutex_ };
+       drain();
+       if ( std::fflush( file_ ) != 0 ) error_.store( errno, std::memory_order_relaxed );
+      }
+
+    private:
+
+     //====================================================
+     //     Private structs
+     //====================================================
+
+     // staging
+     /**
+      * @brief Struct used to store the staging buffer of a thread. It is a single-producer single-consumer ring of bytes: "head" is advanced by the owner thread after a whole record has been copied, "tail" by the writer thread.
+      *
+      */
+     struct staging
+      {
+       explicit staging( std::size_t size ): data( new char[ size ] ), capacity( size ) {}
+
+       std::unique_ptr <char[]> data;
+       std::size_t capacity;
+       alignas( 64 ) std::atomic <std::size_t> head{ 0 };
+       alignas( 64 ) std::atomic <std::size_t> tail{ 0 };
+       std::atomic <bool> in_use{ true }, closed{ false };
+      };
+
+     // thread_stagings
+     /**
+      * @brief Struct used to store the staging buffers of a thread, one for each BinaryLog object it uses.
+      *
+      */
+     struct thread_stagings
+      {
+       ~thread_stagings()
+        {
+         for ( auto& entry: entries ) entry.second -> in_use.store( false );
+        }
+
+       std::vector <std::pair <std::uint64_t, std::shared_ptr <staging>>> entries;
+      };
+
+     // site_registry
+     /**
+      * @brief Struct used to store the type signatures of all the logged calls. The index of a signature is the identifier written in each record.
+      *
+      */
+     struct site_registry
+      {
+       std::mutex mutex;
+       std::vector <std::string> signatures;
+      };
+
+     //====================================================
+     //     Private methods
+     //====================================================
+
+     // loggable
+     /**
+      * @brief Method used to convert an argument into the value stored in the record: arithmetic values are kept, strings and ptc::style codes are viewed and all the other objects are formatted with fast formatting.
+      *
+      * @tparam T The type of the argument.
+      * @param x The argument.
+      * @return The value stored in the record.
+      */
+     template <class T>
+     static auto loggable( const T& x )
+      {
+       if constexpr( is_string_like_v <std::decay_t<T>> )
+        {
+         if constexpr( std::is_pointer_v <T> ) return x ? std::string_view( x ) : std::string_view();
+         else return std::string_view( x );
+        }
+       else if constexpr( is_style_v <T> ) return x.code;
+       else if constexpr( std::is_integral_v <T> && ! is_wide_character_v <T> ) return x;
+       else if constexpr( ( std::is_same_v <T, float> || std::is_same_v <T, double> ) && float_to_chars ) return x;
+       else
+        {
+         format_buffer::lease buf;
+         buf -> write( x );
+         return text{ buf -> data() };
+        }
+      }
+
+     // text
+     /**
+      * @brief Struct used to store an object formatted by the calling thread.
+      *
+      */
+     struct text
+      {
+       std::string value;
+      };
+
+     // type_code
+     /**
+      * @brief Method used to get the type code of a stored value.
+      *
+      * @tparam T The type of the value.
+      * @return char The type code.
+      */
+     template <class T>
+     static constexpr char type_code()
+      {
+       log_type code = log_type::text;
+       if constexpr( std::is_same_v <T, std::string_view> ) code = log_type::string;
+       else if constexpr( std::is_same_v <T, bool> ) code = log_type::boolean;
+       else if constexpr( is_character_v <T> ) code = log_type::character;
+       else if constexpr( std::is_floating_point_v <T> ) code = sizeof( T ) == 4 ? log_type::f32 : log_type::f64;
+       else if constexpr( std::is_integral_v <T> )
+        {
+         constexpr log_type signed_codes[] = { log_type::i8, log_type::i16, log_type::i32, log_type::i64 };
+         constexpr log_type unsigned_codes[] = { log_type::u8, log_type::u16, log_type::u32, log_type::u64 };
+         constexpr std::size_t index = sizeof( T ) == 1 ? 0 : sizeof( T ) == 2 ? 1 : sizeof( T ) == 4 ? 2 : 3;
+         code = std::is_signed_v <T> ? signed_codes[ index ] : unsigned_codes[ index ];
+        }
+       return static_cast <char> ( code );
+      }
+
+     // site_id
+     /**
+      * @brief Method used to get the identifier of a type signature, which is registered the first time it is used.
+      *
+      * @tparam Ts The types of the stored values.
+      * @return std::uint32_t The identifier of the signature.
+      */
+     template <class... Ts>
+     static std::uint32_t site_id()
+      {
+       static const std::uint32_t id = [](){
+         const char codes[] = { type_code<Ts>()..., '\0' };
+         site_registry& registry = sites();
+         std::lock_guard <std::mutex> lock{ registry.mutex };
+         registry.signatures.emplace_back( codes, sizeof...( Ts ) );
+         return static_cast <std::uint32_t> ( registry.signatures.size() - 1 );
+        }();
+       return id;
+      }
+
+     // record
+     /**
+      * @brief Method used to copy a record into the staging buffer of the calling thread, waiting if it is full.
+      *
+      * @tparam Ts The types of the stored values.
+      * @param values The stored values.
+      */
+     template <class... Ts>
+     void record( const Ts&... values )
+      {
+       const std::uint32_t id = site_id<Ts...>();
+       const std::size_t size = sizeof( id ) + ( stored_size( values ) + ... + 0 );
+       staging& st = local();
+       if ( size > st.capacity )
+        {
+         dropped_.fetch_add( 1, std::memory_order_relaxed );
+         return;
+        }
+
+       std::size_t head = st.head.load( std::memory_order_relaxed );
+       while ( head + size - st.tail.load( std::memory_order_acquire ) > st.capacity ) std::this_thread::yield();
+       put( st, head, &id, sizeof( id ) );
+       ( store( st, head, values ), ... );
+       st.head.store( head, std::memory_order_release );
+      }
+
+     // stored_size
+     /**
+      * @brief Method used to get the number of bytes needed to store a value.
+      *
+      * @tparam T The type of the value.
+      * @param x The value.
+      * @return std::size_t The number of bytes.
+      */
+     template <class T>
+     static std::size_t stored_size( const T& x )
+      {
+       if constexpr( std::is_same_v <T, std::string_view> ) return sizeof( std::uint32_t ) + x.size();
+       else if constexpr( std::is_same_v <T, text> ) return sizeof( std::uint32_t ) + x.value.size();
+       else return sizeof( T );
+      }
+
+     // store
+     /**
+      * @brief Method used to copy a value into a staging buffer. Strings are stored with their length.
+      *
+      * @tparam T The type of the value.
+      * @param st The staging buffer.
+      * @param head The position at which the value is written, advanced past it.
+      * @param x The value.
+      */
+     template <class T>
+     static void store( staging& st, std::size_t& head, const T& x )
+      {
+       if constexpr( std::is_same_v <T, std::string_view> || std::is_same_v <T, text> )
+        {
+         const std::string_view str( x_string( x ) );
+         const auto size = static_cast <std::uint32_t> ( str.size() );
+         put( st, head, &size, sizeof( size ) );
+         put( st, head, str.data(), str.size() );
+        }
+       else put( st, head, &x, sizeof( T ) );
+      }
+
+     // x_string
+     /**
+      * @brief Method used to view a stored string.
+      *
+      * @param x The stored string.
+      * @return std::string_view The view of the string.
+      */
+     static std::string_view x_string( std::string_view x ) { return x; }
+     static std::string_view x_string( const text& x ) { return x.value; }
+
+     // put
+     /**
+      * @brief Method used to copy bytes into a staging buffer, wrapping around its end.
+      *
+      * @param st The staging buffer.
+      * @param head The position at which the bytes are written, advanced past them.
+      * @param src The bytes.
+      * @param size The number of bytes.
+      */
+     static void put( staging& st, std::size_t& head, const void* src, std::size_t size )
+      {
+       const std::size_t index = head % st.capacity;
+       const std::size_t first = std::min( size, st.capacity - index );
+       std::memcpy( st.data.get() + index, src, first );
+       std::memcpy( st.data.get(), static_cast <const char*> ( src ) + first, size - first );
+       head += size;
+      }
+
+     // local
+     /**
+      * @brief Method used to get the staging buffer of the calling thread, creating it the first time.
+      *
+      * @return staging& The staging buffer.
+      */
+     staging& local()
+      {
+       thread_local thread_stagings cache;
+       for ( auto& entry: cache.entries )
+        {
+         if ( entry.first == id_ ) return *entry.second;
+        }
+
+       // Dropping the buffers of destroyed BinaryLog objects
+       for ( auto it = cache.entries.begin(); it != cache.entries.end(); )
+        {
+         if ( it -> second -> closed.load() ) it = cache.entries.erase( it );
+         else ++it;
+        }
+
+       auto st = std::make_shared <staging>( capacity_ );
+        {
+         std::lock_guard <std::mutex> lock{ stagings_mutex_ };
+         stagings_.push_back( st );
+        }
+       cache.entries.emplace_back( id_, st );
+       return *st;
+      }
+
+     // drain
+     /**
+      * @brief Method used to write the new type signatures and all the staged records into the log file. It must be called with the drain mutex locked. The staged records are taken before the signatures, so that each of them is written after the signature it uses.
+      *
+      */
+     void drain()
+      {
+       // Taking the staged records
+       std::vector <std::pair <std::shared_ptr <staging>, std::size_t>> stagings;
+        {
+         std::lock_guard <std::mutex> lock{ stagings_mutex_ };
+         stagings.reserve( stagings_.size() );
+         for ( auto& st: stagings_ ) stagings.emplace_back( st, 0 );
+        }
+       for ( auto& [ st, head ]: stagings ) head = st -> head.load( std::memory_order_acquire );
+
+       // Writing the new type signatures, which have been registered before the taken records were staged
+        {
+         site_registry& registry = sites();
+         std::lock_guard <std::mutex> lock{ registry.mutex };
+         for ( ; written_sites_ < registry.signatures.size(); ++written_sites_ )
+          {
+           const std::uint32_t tag = dictionary_tag, id = static_cast <std::uint32_t> ( written_sites_ );
+           const auto size = static_cast <std::uint32_t> ( registry.signatures[ written_sites_ ].size() );
+           std::fwrite( &tag, sizeof( tag ), 1, file_ );
+           std::fwrite( &id, sizeof( id ), 1, file_ );
+           std::fwrite( &size, sizeof( size ), 1, file_ );
+           std::fwrite( registry.signatures[ written_sites_ ].data(), 1, size, file_ );
+          }
+        }
+
+       // Writing the staged records
+       for ( auto& [ st, head ]: stagings )
+        {
+         const std::size_t tail = st -> tail.load( std::memory_order_relaxed );
+         if ( head == tail ) continue;
+         const std::size_t index = tail % st -> capacity;
+         const std::size_t first = std::min( head - tail, st -> capacity - index );
+         if ( std::fwrite( st -> data.get() + index, 1, first, file_ ) != first ||
+              std::fwrite( st -> data.get(), 1, head - tail - first, file_ ) != head - tail - first ) error_.store( errno, std::memory_order_relaxed );
+         st -> tail.store( head, std::memory_order_release );
+        }
+
+       // Releasing the buffers of exited threads
+       std::lock_guard <std::mutex> lock{ stagings_mutex_ };
+       for ( auto it = stagings_.begin(); it != stagings_.end(); )
+        {
+         if ( ! ( *it ) -> in_use.load() && ( *it ) -> head.load() == ( *it ) -> tail.load() ) it = stagings_.erase( it );
+         else ++it;
+        }
+      }
+
+     // writer_loop
+     /**
+      * @brief Method executed by the writer thread. Staging buffers are polled periodically, so that logging threads never have to notify it.
+      *
+      */
+     void writer_loop()
+      {
+       std::unique_lock <std::mutex> lock{ stop_mutex_ };
+       while ( ! stop_.wait_for( lock, std::chrono::milliseconds( 1 ), [ this ]{ return stopping_; } ) )
+        {
+         std::lock_guard <std::mutex> drain_lock{ drain_mutex_ };
+         drain();
+        }
+      }
+
+     // sites
+     /**
+      * @brief Method used to get the registry of the type signatures, which is shared by all the BinaryLog objects.
+      *
+      * @return site_registry& The registry.
+      */
+     static site_registry& sites()
+      {
+       static site_registry registry;
+       return registry;
+      }
+
+     // next_id
+     /**
+      * @brief Method used to get the counter of the BinaryLog objects, used to identify their staging buffers.
+      *
+      * @return std::atomic <std::uint64_t>& The counter.
+      */
+     static std::atomic <std::uint64_t>& next_id()
+      {
+       static std::atomic <std::uint64_t> counter{ 0 };
+       return counter;
+      }
+
+     //====================================================
+     //     Private attributes
+     //====================================================
+     std::FILE* file_;
+     std::size_t capacity_;
+     std::uint64_t id_;
+     std::vector <std::shared_ptr <staging>> stagings_;
+     std::size_t written_sites_ = 0;
+     std::atomic <int> error_{ 0 };
+     std::atomic <std::uint64_t> dropped_{ 0 };
+     bool stopping_ = false;
+     std::mutex stagings_mutex_, drain_mutex_, stop_mutex_;
+     std::condition_variable stop_;
+     std::thread writer_;
+
+     //====================================================
+     //     Private constants
+     //====================================================
+     static constexpr char magic[ 8 ] = { 'P', 'T', 'C', 'L', 'O', 'G', '1', '\n' };
+     static constexpr std::uint32_t dictionary_tag = 0xFFFFFFFF, run_tag = 0xFFFFFFFE;
+
+     friend bool decode_log( std::istream& in, std::ostream& out );
+   }; // end of BinaryLog class
+
+  //====================================================
+  //     Decoder
+  //====================================================
+
+  // decode_log
+  /**
+   * @brief Function used to render a binary log file to text, as the print function would have done with the separator and the end of the log and with fast formatting (see Print::setFastFormatting).
+   *
+   * @param in The stream from which the binary log is read.
+   * @param out The stream to which the text is written.
+   * @return true If the whole log has been decoded.
+   * @return false If the log is invalid or truncated.
+   */
+  inline bool decode_log( std::istream& in, std::ostream& out )
+   {
+    // Sizes read from the log are checked against the bytes left in the input (if it is seekable) before allocating, and strings are read in parts, so that a corrupted size cannot allocate more memory than the input provides
+    std::uint64_t left = std::numeric_limits <std::uint64_t>::max();
+    if ( const auto begin = in.tellg(); begin != std::streampos( -1 ) && in.seekg( 0, std::ios::end ) )
+     {
+      left = static_cast <std::uint64_t> ( in.tellg() - begin );
+      in.seekg( begin );
+     }
+    auto read = [ &in, &left ]( void* dst, std::size_t size )
+     {
+      if ( size > left ) return false;
+      left -= size;
+      return static_cast <bool> ( in.read( static_cast <char*> ( dst ), static_cast <std::streamsize> ( size ) ) );
+     };
+    auto read_string = [ &read, &left ]( std::string& str )
+     {
+      std::uint32_t size;
+      if ( ! read( &size, sizeof( size ) ) || size > left ) return false;
+      str.clear();
+      while ( str.size() < size )
+       {
+        const std::size_t done = str.size(), part = std::min <std::size_t> ( size - done, std::size_t( 1 ) << 16 );
+        str.resize( done + part );
+        if ( ! read( str.data() + done, part ) ) return false;
+       }
+      return true;
+     };
+
+    // Reading the header
+    char magic[ sizeof( BinaryLog::magic ) ];
+    std::uint32_t byte_order;
+    std::string sep, end;
+    if ( ! read( magic, sizeof( magic ) ) || std::memcmp( magic, BinaryLog::magic, sizeof( magic ) ) != 0 ) return false;
+    if ( ! read( &byte_order, sizeof( byte_order ) ) || byte_order != 0x01020304 ) return false;
+    if ( ! read_string( sep ) || ! read_string( end ) ) return false;
+
+    // Reading the entries
+    std::vector <std::string> signatures;
+    std::vector <std::pair <std::string, log_type>> values;
+    std::string line;
+    std::uint32_t tag;
+    while ( read( &tag, sizeof( tag ) ) )
+     {
+      // Type signature
+      if ( tag == BinaryLog::dictionary_tag )
+       {
+        std::uint32_t id;
+        std::string codes;
+        if ( ! read( &id, sizeof( id ) ) || ! read_string( codes ) ) return false;
+
+        // Identifiers are written in order within a run, therefore a new one is always the next one
+        if ( id > signatures.size() ) return false;
+        if ( id == signatures.size() ) signatures.push_back( std::move( codes ) );
+        else signatures[ id ] = std::move( codes );
+        continue;
+       }
+
+      // Run marker of a log appended to the file, whose identifiers restart from 0
+      if ( tag == BinaryLog::run_tag )
+       {
+        if ( ! read_string( sep ) || ! read_string( end ) ) return false;
+        signatures.clear();
+        continue;
+       }
+
+      // Record values
+      if ( tag >= signatures.size() ) return false;
+      values.resize( signatures[ tag ].size() );
+      for ( std::size_t i = 0; i < values.size(); ++i )
+       {
+        const auto code = static_cast <log_type> ( signatures[ tag ][ i ] );
+        std::string& str = values[ i ].first;
+        values[ i ].second = code;
+        auto write_chars = [ &read, &str ]( auto x )
+         {
+          if ( ! read( &x, sizeof( x ) ) ) return false;
+          if constexpr( std::is_integral_v <decltype( x )> || float_to_chars )
+           {
+            char chars[ 64 ];
+            str.assign( chars, std::to_chars( chars, chars + sizeof( chars ), x ).ptr );
+           }
+          return true;
+         };
+        bool ok = true;
+        switch( code )
+         {
+          case log_type::i8: ok = write_chars( std::int8_t() ); break;
+          case log_type::i16: ok = write_chars( std::int16_t() ); break;
+          case log_type::i32: ok = write_chars( std::int32_t() ); break;
+          case log_type::i64: ok = write_chars( std::int64_t() ); break;
+          case log_type::u8: ok = write_chars( std::uint8_t() ); break;
+          case log_type::u16: ok = write_chars( std::uint16_t() ); break;
+          case log_type::u32: ok = write_chars( std::uint32_t() ); break;
+          case log_type::u64: ok = write_chars( std::uint64_t() ); break;
+          case log_type::f32: ok = write_chars( float() ); break;
+          case log_type::f64: ok = write_chars( double() ); break;
+          case log_type::character: { char c; ok = read( &c, 1 ); str.assign( 1, c ); break; }
+          case log_type::boolean: { unsigned char b; ok = read( &b, 1 ); str.assign( 1, b != 0 ? '1' : '0' ); break; }
+          case log_type::string: case log_type::text: ok = read_string( str ); break;
+          default: return false;
+         }
+        if ( ! ok ) return false;
+       }
+
+      // Rendering the record as the print function
+      if ( values.empty() )
+       {
+        out << end;
+        continue;
+       }
+      auto is_string = [ &values ]( std::size_t i ){ return values[ i ].second == log_type::string; };
+      const std::string& first = values[ 0 ].first;
+      const bool first_escape = is_string( 0 ) && ( first.empty() || ( first[ 0 ] == '\033' && first.size() < 7 ) );
+      bool reset = false;
+      line = first;
+      for ( std::size_t i = 0; i < values.size(); ++i )
+       {
+        reset = reset || ( is_string( i ) && ! values[ i ].first.empty() && values[ i ].first[ 0 ] == '\033' );
+        if ( i == 0 ) continue;
+        if ( first_escape ) line.append( values[ i ].first ).append( sep );
+        else line.append( sep ).append( values[ i ].first );
+       }
+      line.append( end );
+      if ( reset ) line.append( "\033[0m" );
+      out << line;
+     }
+    return left == 0 || in.eof();
+   }
+ } // end of namespace ptc
+
+#endif
@@ -0,0 +1,140 @@
+//====================================================
+//     Metadata
+//====================================================
+/**
+ * @file buffered_print.hpp
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Preprocessor directives
+//====================================================
+#ifndef BUFFERED_PRINT_HPP
+#define BUFFERED_PRINT_HPP
+#pragma once
+
+//====================================================
+//     Headers
+//====================================================
+#include "print.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ptc
+ {
+  //====================================================
+  //     buffer_flusher struct
+  //====================================================
+  /**
+   * @brief Struct used to enforce the deadline of the buffered output mode (see Print::setBuffer) with a background thread, which commits each line buffer when the deadline since its first pending line expires, also if its thread does not print anymore. Including this header installs the flusher, otherwise the deadline is only checked when a thread prints. The flusher thread is started the first time a line is buffered and it is stopped when the program exits.
+   *
+   */
+  struct buffer_flusher
+   {
+    //====================================================
+    //     Public structs
+    //====================================================
+
+    // state
+    /**
+     * @brief Struct used to store the flusher thread and its wake-up condition, which are guarded by the mutex of the line buffers registry.
+     *
+     */
+    struct state
+     {
+      std::condition_variable wake;
+      std::thread thread;
+      bool woken = false, stopping = false;
+     };
+
+    // guard
+    /**
+     * @brief Struct used to stop the flusher thread when the program exits.
+     *
+     */
+    struct guard
+     {
+      ~guard()
+       {
+        state& flusher = get();
+         {
+          std::lock_guard <std::mutex> lock{ Print::line_buffers().mutex };
+          flusher.stopping = true;
+         }
+        flusher.wake.notify_one();
+        flusher.thread.join();
+       }
+     };
+
+    //====================================================
+    //     Public methods
+    //====================================================
+
+    // get
+    /**
+     * @brief Method used to get the state of the flusher. It is never deallocated, like the registry of the line buffers.
+     *
+     * @return state& The state.
+     */
+    static state& get()
+     {
+      static state* const flusher = new state();
+      return *flusher;
+     }
+
+    // wake
+    /**
+     * @brief Method used to wake the flusher thread, starting it the first time.
+     *
+     */
+    static void wake()
+     {
+      state& flusher = get();
+       {
+        std::lock_guard <std::mutex> lock{ Print::line_buffers().mutex };
+        if ( flusher.stopping ) return;
+        if ( ! flusher.thread.joinable() ) flusher.thread = std::thread( loop );
+        flusher.woken = true;
+       }
+      static guard stopper;
+      flusher.wake.notify_one();
+     }
+
+    // loop
+    /**
+     * @brief Method executed by the flusher thread. It commits the expired buffers and sleeps until the next deadline.
+     *
+     */
+    static void loop()
+     {
+      state& flusher = get();
+      auto& registry = Print::line_buffers();
+      std::unique_lock <std::mutex> lock{ registry.mutex };
+      while ( ! flusher.stopping )
+       {
+        const auto now = std::chrono::steady_clock::now();
+        auto next = std::chrono::steady_clock::time_point::max();
+        for ( auto* buffer: registry.buffers )
+         {
+          std::lock_guard <std::mutex> buffer_lock{ buffer -> mutex };
+          if ( buffer -> pending.empty() ) continue;
+          if ( now - buffer -> first_line >= buffer -> deadline ) buffer -> commit_locked( false );
+          else next = std::min( next, buffer -> first_line + buffer -> deadline );
+         }
+        flusher.woken = false;
+        auto ready = [ &flusher ]{ return flusher.woken || flusher.stopping; };
+        if ( next == std::chrono::steady_clock::time_point::max() ) flusher.wake.wait( lock, ready );
+        else flusher.wake.wait_until( lock, next, ready );
+       }
+     }
+
+    inline static const bool installed = ( Print::wake_flusher_ = wake, true );
+   }; // end of buffer_flusher struct
+ } // end of namespace ptc
+
+#endif
@@ -0,0 +1,256 @@
+//====================================================
+//     Metadata
+//====================================================
+/**
+ * @file file_sink.hpp
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Preprocessor directives
+//====================================================
+#ifndef FILE_SINK_HPP
+#define FILE_SINK_HPP
+#pragma once
+
+//====================================================
+//     Headers
+//====================================================
+#include "print.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace ptc
+ {
+  //====================================================
+  //     Enum classes
+  //====================================================
+
+  // sync_policy
+  /**
+   * @brief Enum class used to choose when the data written by a FileSink object is synchronized to the storage device with fdatasync: never (none), when a flush is requested (on_flush) or after each write (always).
+   *
+   */
+   enum class sync_policy { none, on_flush, always };
+
+  //====================================================
+  //     FileSink class
+  //====================================================
+  /**
+   * @brief Class used to print directly to a POSIX file descriptor, without passing through std::ofstream. Files are opened with O_APPEND, therefore each print call is appended with a single write and whole lines stay atomic also across different processes writing to the same file. Ex: "ptc::FileSink sink( "log.txt" ); ptc::print( sink, "Hello" );".
+   *
+   */
+  class FileSink
+   {
+    public:
+
+     //====================================================
+     //     Public constructors and destructor
+     //====================================================
+
+     // Path constructor
+     /**
+      * @brief Construct a new FileSink object by opening (or creating) a file in append mode.
+      *
+      * @param path The path of the file.
+      * @param buffer_size If nonzero, print calls are batched in memory and written when this size is reached, when a flush is requested or when the object is destroyed.
+      * @param policy The fdatasync policy.
+      */
+     explicit FileSink( const std::string& path, std::size_t buffer_size = 0, sync_policy policy = sync_policy::none ):
+      fd_( ::open( path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644 ) ),
+      owned_( true ),
+      buffer_size_( buffer_size ),
+      policy_( policy )
+      {
+       if ( fd_ < 0 ) throw std::system_error( errno, std::generic_category(), "ptc::FileSink cannot open " + path );
+       pending_.reserve( buffer_size_ );
+      }
+
+     // Descriptor constructor
+     /**
+      * @brief Construct a new FileSink object which writes to an already open file descriptor (ex: STDOUT_FILENO). The descriptor is not closed by the object.
+      *
+      * @param fd The file descriptor.
+      * @param buffer_size If nonzero, print calls are batched in memory and written when this size is reached, when a flush is requested or when the object is destroyed.
+      * @param policy The fdatasync policy.
+      */
+     explicit FileSink( int fd, std::size_t buffer_size = 0, sync_policy policy = sync_policy::none ):
+      fd_( fd ),
+      owned_( false ),
+      buffer_size_( buffer_size ),
+      policy_( policy )
+      {
+       pending_.reserve( buffer_size_ );
+      }
+
+     // Destructor
+     /**
+      * @brief Destroy the FileSink object, writing the batched print calls and closing the file if owned.
+      *
+      */
+     ~FileSink()
+      {
+       flush();
+       if ( owned_ ) ::close( fd_ );
+      }
+
+     FileSink( const FileSink& ) = delete;
+     FileSink& operator =( const FileSink& ) = delete;
+
+     //====================================================
+     //     Public getters
+     //====================================================
+
+     // getError
+     /**
+      * @brief Getter used to get the last error occurred while writing or synchronizing the file.
+      *
+      * @return std::error_code The last error, or an empty error code.
+      */
+     std::error_code getError() const
+      {
+       return { error_.load( std::memory_order_relaxed ), std::generic_category() };
+      }
+
+     //====================================================
+     //     Public methods
+     //====================================================
+
+     // write
+     /**
+      * @brief Method used to write a whole formatted print call. Without batching the line is written with a single system call and no lock is taken, since O_APPEND writes are atomic. With batching the line is appended to the batch, and a full batch is written together with the new line with a single writev.
+      *
+      * @param line The formatted print call.
+      * @param flush_val If true, the batch is written and synchronized according to the sync policy.
+      */
+     void write( std::string_view line, bool flush_val )
+      {
+       if ( ! buffer_size_ )
+        {
+         const std::string_view parts[] = { line };
+         write_parts( parts, 1 );
+         if ( policy_ == sync_policy::always || ( flush_val && policy_ == sync_policy::on_flush ) ) sync();
+         return;
+        }
+
+       std::lock_guard <std::mutex> lock{ mutex_ };
+       if ( ! flush_val && pending_.size() + line.size() <= buffer_size_ )
+        {
+         pending_.append( line.data(), line.size() );
+         return;
+        }
+       const std::string_view parts[] = { pending_, line };
+       write_parts( parts, 2 );
+       pending_.clear();
+       if ( policy_ == sync_policy::always || ( flush_val && policy_ == sync_policy::on_flush ) ) sync();
+      }
+
+     // flush
+     /**
+      * @brief Method used to write the batched print calls and to synchronize the file, unless the sync policy is none.
+      *
+      */
+     void flush()
+      {
+       std::lock_guard <std::mutex> lock{ mutex_ };
+       if ( ! pending_.empty() )
+        {
+         const std::string_view parts[] = { pending_ };
+         write_parts( parts, 1 );
+         pending_.clear();
+        }
+       if ( policy_ != sync_policy::none ) sync();
+      }
+
+    private:
+
+     //====================================================
+     //     Private methods
+     //====================================================
+
+     // write_parts
+     /**
+      * @brief Method used to write a list of buffers with writev, retrying after partial writes and interruptions.
+      *
+      * @param parts The buffers to be written.
+      * @param n_parts The number of buffers.
+      */
+     void write_parts( const std::string_view* parts, int n_parts )
+      {
+       iovec iov[ 2 ];
+       int count = 0;
+       for ( int i = 0; i < n_parts; ++i )
+        {
+         if ( parts[ i ].empty() ) continue;
+         iov[ count ].iov_base = const_cast <char*> ( parts[ i ].data() );
+         iov[ count ].iov_len = parts[ i ].size();
+         ++count;
+        }
+
+       iovec* first = iov;
+       while ( count > 0 )
+        {
+         ssize_t written = ::writev( fd_, first, count );
+         if ( written < 0 )
+          {
+           if ( errno == EINTR ) continue;
+           error_.store( errno, std::memory_order_relaxed );
+           return;
+          }
+         while ( count > 0 && static_cast <std::size_t> ( written ) >= first -> iov_len )
+          {
+           written -= static_cast <ssize_t> ( first -> iov_len );
+           ++first;
+           --count;
+          }
+         if ( count > 0 )
+          {
+           first -> iov_base = static_cast <char*> ( first -> iov_base ) + written;
+           first -> iov_len -= static_cast <std::size_t> ( written );
+          }
+        }
+      }
+
+     // sync
+     /**
+      * @brief Method used to synchronize the written data to the storage device.
+      *
+      */
+     void sync()
+      {
+       #ifdef __APPLE__
+        const int result = ::fsync( fd_ );
+       #else
+        const int result = ::fdatasync( fd_ );
+       #endif
+       if ( result < 0 && errno != EINVAL ) error_.store( errno, std::memory_order_relaxed );
+      }
+
+     //====================================================
+     //     Private attributes
+     //====================================================
+     int fd_;
+     bool owned_;
+     std::size_t buffer_size_;
+     sync_policy policy_;
+     std::string pending_;
+     std::mutex mutex_;
+     std::atomic <int> error_{ 0 };
+   }; // end of FileSink class
+
+  // is_sink specialization
+  template <>
+  struct is_sink <FileSink>: std::true_type {};
+ } // end of namespace ptc
+
+#endif
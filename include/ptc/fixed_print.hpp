@@ -0,0 +1,414 @@
+//====================================================
+//     Metadata
+//====================================================
+/**
+ * @file fixed_print.hpp
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Preprocessor directives
+//====================================================
+#ifndef FIXED_PRINT_HPP
+#define FIXED_PRINT_HPP
+#pragma once
+
+//====================================================
+//     Headers
+//====================================================
+#include "print.hpp"
+#include "static_print.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <complex>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#ifdef _WIN32
+ #include <io.h>
+#else
+ #include <unistd.h>
+#endif
+
+namespace ptc
+ {
+  //====================================================
+  //     Helper tools
+  //====================================================
+
+  // fixed_buffer
+  /**
+   * @brief Class used to format a print call into a fixed-capacity buffer stored inline (ex: on the stack), without any allocation. The last "Reserved" characters are kept free for the end of the line, therefore a call longer than the buffer is truncated but still terminated.
+   *
+   * @tparam Capacity The size of the buffer.
+   * @tparam Reserved The number of characters reserved for the end of the line.
+   */
+  template <std::size_t Capacity, std::size_t Reserved>
+  class fixed_buffer
+   {
+    static_assert( Capacity > Reserved, "The capacity of the buffer must be larger than the end of the line." );
+
+    public:
+
+     // view
+     /**
+      * @brief Getter used to get the formatted content of the buffer.
+      *
+      * @return std::string_view The formatted content.
+      */
+     std::string_view view() const
+      {
+       return { data_, size_ };
+      }
+
+     // truncated
+     /**
+      * @brief Getter used to check if some characters did not fit into the buffer.
+      *
+      * @return true If the output has been truncated.
+      * @return false Otherwise.
+      */
+     bool truncated() const
+      {
+       return truncated_;
+      }
+
+     // append
+     /**
+      * @brief Method used to append a string, truncated to the free space before the reserved end.
+      *
+      * @param str The string to be appended.
+      */
+     void append( std::string_view str )
+      {
+       const std::size_t n = std::min( str.size(), Capacity - Reserved - size_ );
+       std::memcpy( data_ + size_, str.data(), n );
+       size_ += n;
+       truncated_ = truncated_ || n < str.size();
+      }
+
+     // push_back
+     /**
+      * @brief Method used to append a single character.
+      *
+      * @param c The character.
+      */
+     void push_back( char c )
+      {
+       if ( size_ < Capacity - Reserved ) data_[ size_++ ] = c;
+       else truncated_ = true;
+      }
+
+     // append_end
+     /**
+      * @brief Method used to append the end of the line into the reserved space.
+      *
+      * @param str The end of the line, at most "Reserved" characters long.
+      */
+     void append_end( std::string_view str )
+      {
+       std::memcpy( data_ + size_, str.data(), str.size() );
+       size_ += str.size();
+      }
+
+    private:
+     char data_[ Capacity ];
+     std::size_t size_ = 0;
+     bool truncated_ = false;
+   };
+
+  //====================================================
+  //     FixedPrint class
+  //====================================================
+  /**
+   * @brief Class used to construct a print function which never allocates memory, for threads in which heap allocations are forbidden (ex: real-time audio threads). Each call is formatted into a buffer of "Capacity" characters on the stack, without std::ostream, and separators are compile-time constants. Strings, characters, booleans, arithmetic types, ANSI styles, std::complex, std::pair, containers, std::array and C arrays are supported; calls longer than the buffer are truncated. The output is written to the standard output file descriptor with a single write (POSIX write, or _write on Windows), to an output sink or to a caller-provided character buffer (see ptc::to). Ex: "ptc::FixedPrint<256> rt_print;".
+   *
+   * @tparam Capacity The size of the buffer used for each call.
+   * @tparam Sep The separator, as a ptc::chars string.
+   * @tparam End The end of the line, as a ptc::chars string.
+   * @tparam Flush If true, output sinks are flushed after each call.
+   */
+  template <std::size_t Capacity = 512, class Sep = chars<' '>, class End = chars<'\n'>, bool Flush = false>
+  class FixedPrint
+   {
+    public:
+
+     //====================================================
+     //     Public getters
+     //====================================================
+
+     // getEnd
+     /**
+      * @brief Getter used to get the value of the "end" variable.
+      *
+      * @return std::string_view The value of the "end" variable.
+      */
+     static constexpr std::string_view getEnd()
+      {
+       return End::view;
+      }
+
+     // getSep
+     /**
+      * @brief Getter used to get the value of the "sep" variable.
+      *
+      * @return std::string_view The value of the "sep" variable.
+      */
+     static constexpr std::string_view getSep()
+      {
+       return Sep::view;
+      }
+
+     // getCapacity
+     /**
+      * @brief Getter used to get the size of the buffer used for each call.
+      *
+      * @return std::size_t The size of the buffer.
+      */
+     static constexpr std::size_t getCapacity()
+      {
+       return Capacity;
+      }
+
+     //====================================================
+     //     Public operators
+     //====================================================
+
+     // General case
+     /**
+      * @brief Frontend implementation of the () operator overload to print to the standard output file descriptor (or to an output sink).
+      *
+      * @tparam T Generic type of first object to be printed (or the output sink).
+      * @tparam Args Generic type of all the other objects to be printed.
+      * @param first First object to be printed (or the output sink).
+      * @param args The list of all the other objects to be printed.
+      * @return bool False if the output has been truncated (or it could not be written).
+      */
+     template <class T, class... Args>
+     bool operator()( T&& first, Args&&... args ) const
+      {
+       buffer_type buf;
+       if constexpr ( is_sink_v <T> )
+        {
+         format_args( buf, std::forward<Args>( args )... );
+         first.write( buf.view(), Flush );
+        }
+       else
+        {
+         format_args( buf, std::forward<T>( first ), std::forward<Args>( args )... );
+         if ( ! write_fd( stdout_fd, buf.view() ) ) return false;
+        }
+       return ! buf.truncated();
+      }
+
+     // No arguments case
+     /**
+      * @brief Operator redefinition used to print an empty line to the standard output file descriptor.
+      *
+      * @return bool False if the output could not be written.
+      */
+     bool operator()() const
+      {
+       buffer_type buf;
+       format_args( buf );
+       return write_fd( stdout_fd, buf.view() );
+      }
+
+     // Bounded target case
+     /**
+      * @brief Frontend implementation of the () operator overload to print into a caller-provided character buffer (see ptc::to). The output is truncated to the size of the target.
+      *
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param first The target buffer.
+      * @param args The list of all the objects to be printed.
+      * @return to_n_result <char*> The end of the written characters and the size of the formatted content.
+      */
+     template <class... Args>
+     to_n_result <char*> operator()( bounded_target <char*>&& first, Args&&... args ) const
+      {
+       buffer_type buf;
+       format_args( buf, std::forward<Args>( args )... );
+       const std::string_view data = buf.view();
+       return { std::copy_n( data.begin(), std::min( data.size(), first.n ), first.out ), data.size() };
+      }
+
+     // String initialization case
+     /**
+      * @brief Deleted overload: the std::string mode allocates memory.
+      *
+      */
+     template <class... Args>
+     void operator()( mode&&, Args&&... ) const = delete;
+
+     // String target case
+     /**
+      * @brief Deleted overload: printing into an std::string may allocate memory.
+      *
+      */
+     template <class... Args>
+     void operator()( string_target&&, Args&&... ) const = delete;
+
+    private:
+
+     //====================================================
+     //     Private types and constants
+     //====================================================
+     using end_reset = typename concat_chars <End, chars<'\033', '[', '0', 'm'>>::type;
+     using buffer_type = fixed_buffer <Capacity, end_reset::view.size()>;
+     #ifdef _WIN32
+      static constexpr int stdout_fd = 1;
+     #else
+      static constexpr int stdout_fd = STDOUT_FILENO;
+     #endif
+
+     //====================================================
+     //     Private methods
+     //====================================================
+
+     // format_args
+     /**
+      * @brief Method used to write all the arguments, separators, end and ANSI reset sequence of a print call into the buffer, with the same rules of the Print class.
+      *
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param buf The buffer.
+      * @param args The list of objects to be printed.
+      */
+     template <class... Args>
+     static void format_args( buffer_type& buf, Args&&... args )
+      {
+       if constexpr( sizeof...( args ) > 0 ) format_objects( buf, args... );
+       else buf.append_end( End::view );
+      }
+
+     // format_objects
+     /**
+      * @brief Method used to write the arguments of a non-empty print call.
+      *
+      * @tparam T Generic type of first object to be printed.
+      * @tparam Args Generic type of all the other objects to be printed.
+      * @param buf The buffer.
+      * @param first First printed object.
+      * @param args The list of objects to be printed.
+      */
+     template <class T, class... Args>
+     static void format_objects( buffer_type& buf, const T& first, const Args&... args )
+      {
+       write( buf, first );
+       if constexpr( sizeof...( args ) > 0 )
+        {
+         if ( Print::is_null_str( first ) || Print::is_escape( first, ANSI::first ) ) ( ( write( buf, args ), buf.append( Sep::view ) ), ...);
+         else ( ( buf.append( Sep::view ), write( buf, args ) ), ...);
+        }
+
+       bool reset = false;
+       if constexpr( ( is_style_v<T> || ... || is_style_v<Args> ) ) reset = true;
+       else if constexpr( ( is_string_like_v<std::decay_t<T>> || ... || is_string_like_v<std::decay_t<Args>> ) )
+        {
+         reset = Print::is_escape( first, ANSI::generic ) || ( Print::is_escape( args, ANSI::generic ) || ... );
+        }
+       buf.append_end( reset ? end_reset::view : End::view );
+      }
+
+     // write
+     /**
+      * @brief Method used to write an object into the buffer. Unsupported types are rejected at compile time, since they would require an std::ostream.
+      *
+      * @tparam T The type of the object.
+      * @param buf The buffer.
+      * @param x The object to be written.
+      */
+     template <class T>
+     static void write( buffer_type& buf, const T& x )
+      {
+       if constexpr( is_string_like_v <std::decay_t<T>> )
+        {
+         if constexpr( std::is_array_v <T> || std::is_pointer_v <T> )
+          {
+           const char* data = x;
+           if ( data ) buf.append( data );
+          }
+         else buf.append( std::string_view( x ) );
+        }
+       else if constexpr( std::is_same_v <T, std::nullptr_t> ) buf.append( "nullptr" );
+       else if constexpr( is_style_v <T> ) buf.append( x.code );
+       else if constexpr( is_character_v <T> ) buf.push_back( static_cast <char> ( x ) );
+       else if constexpr( std::is_same_v <T, bool> ) buf.push_back( x ? '1' : '0' );
+       else if constexpr( std::is_integral_v <T> && ! is_wide_character_v <T> )
+        {
+         char chars[ std::numeric_limits <T>::digits10 + 3 ];
+         buf.append( { chars, static_cast <std::size_t> ( std::to_chars( chars, chars + sizeof( chars ), x ).ptr - chars ) } );
+        }
+       else if constexpr( std::is_floating_point_v <T> )
+        {
+         char chars[ 48 ];
+         if constexpr( float_to_chars ) buf.append( { chars, static_cast <std::size_t> ( std::to_chars( chars, chars + sizeof( chars ), x ).ptr - chars ) } );
+         else buf.append( { chars, static_cast <std::size_t> ( std::max( std::snprintf( chars, sizeof( chars ), "%g", static_cast <double> ( x ) ), 0 ) ) } );
+        }
+       else if constexpr( is_complex_v <T> )
+        {
+         write( buf, x.real() );
+         buf.push_back( '+' );
+         write( buf, x.imag() );
+         buf.push_back( 'j' );
+        }
+       else if constexpr( is_pair_v <T> )
+        {
+         buf.push_back( '[' );
+         write( buf, x.first );
+         buf.append( ", " );
+         write( buf, x.second );
+         buf.push_back( ']' );
+        }
+       else if constexpr( is_container_v <T> || is_c_array_v <T> || is_numeric_range_v <T> )
+        {
+         buf.push_back( '[' );
+         bool first = true;
+         for ( const auto& elem: x )
+          {
+           if ( ! first ) buf.append( ", " );
+           write( buf, elem );
+           first = false;
+          }
+         buf.push_back( ']' );
+        }
+       else static_assert( sizeof( T ) == 0, "This type is not supported by FixedPrint, since it would require an std::ostream." );
+      }
+
+     // write_fd
+     /**
+      * @brief Method used to write the formatted content to a file descriptor, retrying after partial writes and signal interruptions.
+      *
+      * @param fd The file descriptor.
+      * @param data The content to be written.
+      * @return bool False if an error occurred.
+      */
+     static bool write_fd( int fd, std::string_view data )
+      {
+       while ( ! data.empty() )
+        {
+         #ifdef _WIN32
+          const int written = ::_write( fd, data.data(), static_cast <unsigned> ( std::min <std::size_t> ( data.size(), std::numeric_limits <int>::max() ) ) );
+         #else
+          const ssize_t written = ::write( fd, data.data(), data.size() );
+         #endif
+         if ( written < 0 )
+          {
+           if ( errno == EINTR ) continue;
+           return false;
+          }
+         data.remove_prefix( static_cast <std::size_t> ( written ) );
+        }
+       return true;
+      }
+   }; // end of FixedPrint class
+ } // end of namespace ptc
+
+#endif
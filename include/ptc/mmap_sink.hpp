@@ -0,0 +1,464 @@
+//====================================================
+//     Metadata
+//====================================================
+/**
+ * @file mmap_sink.hpp
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Preprocessor directives
+//====================================================
+#ifndef MMAP_SINK_HPP
+#define MMAP_SINK_HPP
+#pragma once
+
+//====================================================
+//     Headers
+//====================================================
+#include "print.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace ptc
+ {
+  //====================================================
+  //     MmapSink class
+  //====================================================
+  /**
+   * @brief Class used to print into a sequence of pre-sized memory-mapped log files ("path.0", "path.1", ...). Each print call reserves its bytes with an atomic bump pointer and is copied by the calling thread, therefore writers never take a lock. A segment is rotated when it is full or, optionally, when it is older than a given time; the next segment is created and mapped in advance by a background thread. The unused tail of each segment is truncated when it is closed. Existing files are never overwritten: the numbering skips the segments left by a previous run. It is available only on POSIX systems. Ex: "ptc::MmapSink sink( "service.log" ); ptc::print( sink, "Hello" );".
+   *
+   */
+  class MmapSink
+   {
+    public:
+
+     //====================================================
+     //     Public constructors and destructor
+     //====================================================
+
+     // Constructor
+     /**
+      * @brief Construct a new MmapSink object, creating and mapping its first segment.
+      *
+      * @param path The base path of the segments.
+      * @param segment_size The size of each segment.
+      * @param rotate_after If nonzero, segments older than this time are rotated even if they are not full.
+      */
+     explicit MmapSink( const std::string& path, std::size_t segment_size = std::size_t( 64 ) << 20, std::chrono::milliseconds rotate_after = std::chrono::milliseconds( 0 ) ):
+      path_( path ),
+      segment_size_( std::max( segment_size, page_size() ) ),
+      rotate_after_( rotate_after )
+      {
+       segment* first = create_segment( segment_size_ );
+       if ( ! first ) throw std::system_error( getError(), "ptc::MmapSink cannot create a segment of " + path );
+       current_.store( first );
+       worker_ = std::thread( [ this ]{ worker_loop(); } );
+      }
+
+     // Destructor
+     /**
+      * @brief Destroy the MmapSink object, closing all the segments and truncating their unused tail. The object must not be used by other threads anymore.
+      *
+      */
+     ~MmapSink()
+      {
+        {
+         std::lock_guard <std::mutex> lock{ mutex_ };
+         stopping_ = true;
+        }
+       wake_.notify_one();
+       worker_.join();
+
+       close_segment( current_.load() );
+       for ( segment* seg: retired_ ) close_segment( seg );
+       if ( next_ )
+        {
+         ::munmap( next_ -> data, next_ -> size );
+         ::close( next_ -> fd );
+         ::unlink( next_ -> path.c_str() );
+        }
+      }
+
+     MmapSink( const MmapSink& ) = delete;
+     MmapSink& operator =( const MmapSink& ) = delete;
+
+     //====================================================
+     //     Public getters
+     //====================================================
+
+     // getError
+     /**
+      * @brief Getter used to get the last error occurred while creating, synchronizing or closing a segment.
+      *
+      * @return std::error_code The last error, or an empty error code.
+      */
+     std::error_code getError() const
+      {
+       return { error_.load( std::memory_order_relaxed ), std::generic_category() };
+      }
+
+     // getDropped
+     /**
+      * @brief Getter used to get the number of print calls discarded because a new segment could not be created.
+      *
+      * @return std::uint64_t The number of discarded print calls.
+      */
+     std::uint64_t getDropped() const
+      {
+       return dropped_.load( std::memory_order_relaxed );
+      }
+
+     //====================================================
+     //     Public methods
+     //====================================================
+
+     // write
+     /**
+      * @brief Method used to write a whole formatted print call. The bytes are reserved in the current segment with an atomic bump pointer and copied without any lock. If the segment is full it is rotated and the reservation is retried in the new one.
+      *
+      * @param line The formatted print call.
+      * @param flush_val If true, the written bytes are synchronized to the storage device with msync.
+      */
+     void write( std::string_view line, bool flush_val )
+      {
+       while ( true )
+        {
+         segment* seg = acquire();
+         const std::size_t offset = seg -> offset.fetch_add( line.size() );
+         if ( offset + line.size() <= seg -> size )
+          {
+           std::memcpy( seg -> data + offset, line.data(), line.size() );
+           if ( flush_val ) sync( seg, offset, line.size() );
+           seg -> users.fetch_sub( 1 );
+           return;
+          }
+
+         // The first failed reservation marks the end of the data of the segment
+         std::size_t failed = seg -> failed.load();
+         while ( offset < failed && ! seg -> failed.compare_exchange_weak( failed, offset ) ) {}
+         const bool rotated = rotate( seg, line.size() );
+         seg -> users.fetch_sub( 1 );
+         if ( ! rotated )
+          {
+           dropped_.fetch_add( 1, std::memory_order_relaxed );
+           return;
+          }
+        }
+      }
+
+     // flush
+     /**
+      * @brief Method used to synchronize the current segment to the storage device.
+      *
+      */
+     void flush()
+      {
+       segment* seg = acquire();
+       sync( seg, 0, std::min( seg -> offset.load(), seg -> size ) );
+       seg -> users.fetch_sub( 1 );
+      }
+
+    private:
+
+     //====================================================
+     //     Private structs
+     //====================================================
+
+     // segment
+     /**
+      * @brief Struct used to store a mapped segment. "users" counts the writers which may still access its mapping, "failed" is the smallest offset of a reservation which did not fit.
+      *
+      */
+     struct segment
+      {
+       char* data = nullptr;
+       std::size_t size = 0;
+       int fd = -1;
+       std::string path;
+       std::chrono::steady_clock::time_point created;
+       std::atomic <std::size_t> offset{ 0 };
+       std::atomic <std::size_t> failed{ std::numeric_limits <std::size_t>::max() };
+       std::atomic <int> users{ 0 };
+      };
+
+     //====================================================
+     //     Private methods
+     //====================================================
+
+     // acquire
+     /**
+      * @brief Method used to get the current segment and to register the calling thread as one of its users. The segment is checked again after the registration, so that a segment which is being retired is never accessed. The calling thread is also counted as a reader of the current epoch until it is registered, so that the background thread does not deallocate a segment whose counters it may still read (see release_segments).
+      *
+      * @return segment* The current segment.
+      */
+     segment* acquire()
+      {
+       // Entering the current epoch
+       unsigned epoch = epoch_.load();
+       readers_[ epoch ].fetch_add( 1 );
+       while ( epoch_.load() != epoch )
+        {
+         readers_[ epoch ].fetch_sub( 1 );
+         epoch = epoch_.load();
+         readers_[ epoch ].fetch_add( 1 );
+        }
+
+       // Registering as a user of the current segment
+       segment* seg = current_.load();
+       seg -> users.fetch_add( 1 );
+       while ( current_.load() != seg )
+        {
+         seg -> users.fetch_sub( 1 );
+         seg = current_.load();
+         seg -> users.fetch_add( 1 );
+        }
+       readers_[ epoch ].fetch_sub( 1 );
+       return seg;
+      }
+
+     // rotate
+     /**
+      * @brief Method used to replace a full segment with the next one, which is usually already mapped by the background thread. The replaced segment is closed by the background thread once it has no users anymore.
+      *
+      * @param seg The full segment.
+      * @param min_size The minimum size of the new segment.
+      * @return true If the current segment is not the full one anymore.
+      * @return false If a new segment could not be created.
+      */
+     bool rotate( segment* seg, std::size_t min_size )
+      {
+       std::unique_lock <std::mutex> lock{ mutex_ };
+       if ( current_.load() != seg ) return true;
+
+       segment* next = nullptr;
+       if ( next_ && next_ -> size >= min_size ) std::swap( next, next_ );
+       else 
+        {
+         // Replacing a too small next segment, keeping its place in the sequence
+         std::string path;
+         if ( next_ )
+          {
+           path = next_ -> path;
+           ::munmap( next_ -> data, next_ -> size );
+           ::close( next_ -> fd );
+           ::unlink( path.c_str() );
+           release( next_ );
+           next_ = nullptr;
+          }
+         next = create_segment( std::max( segment_size_, min_size ), std::move( path ) );
+        }
+       if ( ! next ) return false;
+
+       next -> created = std::chrono::steady_clock::now();
+       current_.store( next );
+       retired_.push_back( seg );
+       lock.unlock();
+       wake_.notify_one();
+       return true;
+      }
+
+     // create_segment
+     /**
+      * @brief Method used to create, pre-size and map a new segment file. It must be called with the sink mutex locked (or from the constructor), so that segments are numbered in the order they are used. Files are created exclusively, therefore the indices of existing files are skipped.
+      *
+      * @param size The size of the segment.
+      * @param path The path of the segment file, or an empty string to use the next free one in the sequence.
+      * @return segment* The new segment, or nullptr in case of failure.
+      */
+     segment* create_segment( std::size_t size, std::string path = "" )
+      {
+       const bool next_path = path.empty();
+       int fd = -1;
+       do
+        {
+         if ( next_path ) path = path_ + "." + std::to_string( n_segments_++ );
+         fd = ::open( path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644 );
+        }
+       while ( fd < 0 && errno == EEXIST && next_path );
+       if ( fd < 0 )
+        {
+         error_.store( errno, std::memory_order_relaxed );
+         return nullptr;
+        }
+       void* data = MAP_FAILED;
+       if ( ::ftruncate( fd, static_cast <off_t> ( size ) ) == 0 ) data = ::mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+       if ( data == MAP_FAILED )
+        {
+         error_.store( errno, std::memory_order_relaxed );
+         ::close( fd );
+         ::unlink( path.c_str() );
+         return nullptr;
+        }
+
+       auto seg = std::make_unique <segment>();
+       seg -> data = static_cast <char*> ( data );
+       seg -> size = size;
+       seg -> fd = fd;
+       seg -> path = std::move( path );
+       seg -> created = std::chrono::steady_clock::now();
+
+       segments_.push_back( std::move( seg ) );
+       return segments_.back().get();
+      }
+
+     // release
+     /**
+      * @brief Method used to deallocate a segment which is not mapped anymore.
+      *
+      * @param seg The segment.
+      */
+     void release( segment* seg )
+      {
+       segments_.erase( std::find_if( segments_.begin(), segments_.end(), [ seg ]( const auto& ptr ){ return ptr.get() == seg; } ) );
+      }
+
+     // release_segments
+     /**
+      * @brief Method used to deallocate the closed segments. A thread in acquire may have loaded a closed segment before it was retired, therefore closed segments wait for a grace period: the epoch is switched and they are deallocated once no thread is reading in the previous epoch anymore. It must be called with the sink mutex locked.
+      *
+      */
+     void release_segments()
+      {
+       if ( ! releasing_.empty() && readers_[ epoch_.load() ^ 1 ].load() == 0 )
+        {
+         for ( segment* seg: releasing_ ) release( seg );
+         releasing_.clear();
+        }
+       if ( releasing_.empty() && ! closed_.empty() )
+        {
+         releasing_.swap( closed_ );
+         epoch_.fetch_xor( 1 );
+        }
+      }
+
+     // close_segment
+     /**
+      * @brief Method used to unmap a segment which has no users and to truncate its file to the written data.
+      *
+      * @param seg The segment.
+      */
+     void close_segment( segment* seg )
+      {
+       const std::size_t used = std::min( { seg -> offset.load(), seg -> failed.load(), seg -> size } );
+       ::munmap( seg -> data, seg -> size );
+       if ( ::ftruncate( seg -> fd, static_cast <off_t> ( used ) ) != 0 ) error_.store( errno, std::memory_order_relaxed );
+       ::close( seg -> fd );
+      }
+
+     // sync
+     /**
+      * @brief Method used to synchronize a range of a segment to the storage device.
+      *
+      * @param seg The segment.
+      * @param offset The beginning of the range.
+      * @param size The size of the range.
+      */
+     void sync( segment* seg, std::size_t offset, std::size_t size )
+      {
+       const std::size_t first = offset - offset % page_size();
+       if ( ::msync( seg -> data + first, offset + size - first, MS_SYNC ) != 0 ) error_.store( errno, std::memory_order_relaxed );
+      }
+
+     // worker_loop
+     /**
+      * @brief Method executed by the background thread. It maps the next segment in advance, closes the retired segments once they have no users and rotates the current segment when it is too old.
+      *
+      */
+     void worker_loop()
+      {
+       std::unique_lock <std::mutex> lock{ mutex_ };
+       while ( ! stopping_ )
+        {
+         // Mapping the next segment
+         if ( ! next_ ) next_ = create_segment( segment_size_ );
+
+         // Closing the retired segments and deallocating the closed ones
+         for ( auto it = retired_.begin(); it != retired_.end(); )
+          {
+           if ( ( *it ) -> users.load() == 0 )
+            {
+             close_segment( *it );
+             closed_.push_back( *it );
+             it = retired_.erase( it );
+            }
+           else ++it;
+          }
+         release_segments();
+
+         // Rotating old segments
+         segment* seg = current_.load();
+         if ( rotate_after_.count() && seg -> offset.load() > 0 && std::chrono::steady_clock::now() - seg -> created >= rotate_after_ )
+          {
+           lock.unlock();
+           rotate( seg, 0 );
+           lock.lock();
+           continue;
+          }
+
+         // Waiting for work
+         auto period = retired_.empty() && releasing_.empty() ? std::chrono::milliseconds( 100 ) : std::chrono::milliseconds( 1 );
+         if ( rotate_after_.count() ) period = std::min( period, rotate_after_ );
+         wake_.wait_for( lock, period );
+        }
+      }
+
+     // page_size
+     /**
+      * @brief Method used to get the size of a memory page.
+      *
+      * @return std::size_t The size of a memory page.
+      */
+     static std::size_t page_size()
+      {
+       static const std::size_t size = static_cast <std::size_t> ( ::sysconf( _SC_PAGESIZE ) );
+       return size;
+      }
+
+     //====================================================
+     //     Private attributes
+     //====================================================
+     std::string path_;
+     std::size_t segment_size_;
+     std::chrono::milliseconds rotate_after_;
+     std::atomic <segment*> current_{ nullptr };
+     segment* next_ = nullptr;
+     std::vector <segment*> retired_, closed_, releasing_;
+     std::deque <std::unique_ptr <segment>> segments_;
+     std::atomic <unsigned> epoch_{ 0 };
+     std::atomic <int> readers_[ 2 ] = {};
+     std::size_t n_segments_ = 0;
+     std::atomic <int> error_{ 0 };
+     std::atomic <std::uint64_t> dropped_{ 0 };
+     bool stopping_ = false;
+     std::mutex mutex_;
+     std::condition_variable wake_;
+     std::thread worker_;
+   }; // end of MmapSink class
+
+  // is_sink specialization
+  template <>
+  struct is_sink <MmapSink>: std::true_type {};
+ } // end of namespace ptc
+
+#endif
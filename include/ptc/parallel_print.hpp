@@ -0,0 +1,61 @@
+//====================================================
+//     Metadata
+//====================================================
+/**
+ * @file parallel_print.hpp
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Preprocessor directives
+//====================================================
+#ifndef PARALLEL_PRINT_HPP
+#define PARALLEL_PRINT_HPP
+#pragma once
+
+//====================================================
+//     Headers
+//====================================================
+#include "print.hpp"
+#include <cstddef>
+#include <future>
+#include <vector>
+
+namespace ptc
+ {
+  //====================================================
+  //     parallel_runner struct
+  //====================================================
+  /**
+   * @brief Struct used to enable the parallel formatting of large containers (see Print::setParallel). Including this header installs its runner in the format buffers, therefore programs which do not use parallel formatting do not pull in threads and futures.
+   *
+   */
+  struct parallel_runner
+   {
+    // run
+    /**
+     * @brief Method used to run the parts of a formatting round concurrently. The first part is run by the calling thread, the other ones by std::async, and the method returns once all of them are done. An exception thrown by a part is rethrown to the caller.
+     *
+     * @param task The function which formats a single part.
+     * @param context The context of the task.
+     * @param parts The number of parts.
+     */
+    static void run( void ( *task )( void*, std::size_t ), void* context, std::size_t parts )
+     {
+      std::vector <std::future <void>> futures;
+      futures.reserve( parts );
+      for ( std::size_t part = 1; part < parts; ++part )
+       {
+        futures.push_back( std::async( std::launch::async, task, context, part ) );
+       }
+      task( context, 0 );
+      for ( auto& future: futures ) future.get();
+     }
+
+    inline static const bool installed = ( format_buffer::parallel_run_ = run, true );
+   }; // end of parallel_runner struct
+ } // end of namespace ptc
+
+#endif
@@ -27,6 +27,50 @@
 #include <utility>
 #include <ios>
 #include <complex>
+#include <cstdint>
+#include <cstddef>
+#include <streambuf>
+#include <optional>
+#include <chrono>
+#include <charconv>
+#include <iterator>
+#include <algorithm>
+#include <tuple>
+#include <atomic>
+#include <memory>
+#include <limits>
+#include <cstring>
+#include <vector>
+#include <array>
+
+// The std::pmr::string target (see ptc::str_in) is available only if the standard library provides <memory_resource>
+#if defined( __has_include )
+ #if __has_include( <memory_resource> )
+  #define PTC_MEMORY_RESOURCE
+  #include <memory_resource>
+ #endif
+#endif
+#include <locale>
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+ #define PTC_SSE2
+ #include <emmintrin.h>
+#endif
+
+// Non-template functions are defined in src/print.cpp in case of separate compilation
+#ifdef PTC_SEPARATE_COMPILATION
+ #define PTC_INLINE
+#else
+ #define PTC_INLINE inline
+#endif
+
+// Type-erased backends are shared among all the call sites, therefore they are never inlined
+#if defined( __GNUC__ ) || defined( __clang__ )
+ #define PTC_NOINLINE __attribute__(( noinline ))
+#elif defined( _MSC_VER )
+ #define PTC_NOINLINE __declspec( noinline )
+#else
+ #define PTC_NOINLINE
+#endif
 
 namespace ptc
  {
@@ -48,6 +92,32 @@ namespace ptc
    */
    enum class ANSI { first, generic };
 
+  //====================================================
+  //     ANSI styles
+  //====================================================
+
+  // ansi_style
+  /**
+   * @brief Struct used to store an ANSI escape sequence which is known at compile time. Printing it always resets the stream at the end of the print call, without scanning any string.
+   * 
+   */
+  struct ansi_style
+   {
+    std::string_view code;
+   };
+
+  // style
+  /**
+   * @brief Namespace containing the most common ANSI styles and colors. Ex: "ptc::print( ptc::style::red, "Error!" )".
+   * 
+   */
+  namespace style
+   {
+    inline constexpr ansi_style reset{ "\033[0m" }, bold{ "\033[1m" }, faint{ "\033[2m" }, italic{ "\033[3m" }, underline{ "\033[4m" }, blink{ "\033[5m" }, inverse{ "\033[7m" }, crossed{ "\033[9m" };
+    inline constexpr ansi_style black{ "\033[30m" }, red{ "\033[31m" }, green{ "\033[32m" }, yellow{ "\033[33m" }, blue{ "\033[34m" }, magenta{ "\033[35m" }, cyan{ "\033[36m" }, white{ "\033[37m" };
+    inline constexpr ansi_style bg_black{ "\033[40m" }, bg_red{ "\033[41m" }, bg_green{ "\033[42m" }, bg_yellow{ "\033[43m" }, bg_blue{ "\033[44m" }, bg_magenta{ "\033[45m" }, bg_cyan{ "\033[46m" }, bg_white{ "\033[47m" };
+   }
+
   //====================================================
   //     Helper tools
   //====================================================
@@ -72,10 +142,173 @@ namespace ptc
   template<class T>
   inline constexpr bool is_streamable_v = is_streamable<T>::value;
 
+  // is_string_like
+  /**
+   * @brief Struct used to define a type trait for narrow strings (C strings, std::basic_string and std::string_view), which are written as they are.
+   * 
+   * @tparam T 
+   */
+  template <class T>
+  struct is_string_like: std::bool_constant< std::is_same_v <std::decay_t<T>, const char*> || std::is_same_v <std::decay_t<T>, char*> || std::is_same_v <T, std::string_view>> {};
+
+  template <class Traits, class Alloc>
+  struct is_string_like <std::basic_string <char, Traits, Alloc>>: std::true_type {};
+
+  template <class T>
+  inline constexpr bool is_string_like_v = is_string_like<T>::value;
+
+  // is_style
+  /**
+   * @brief Struct used to check if a type is an ANSI style.
+   * 
+   * @tparam T The type to be checked.
+   */
+  template <class T>
+  inline constexpr bool is_style_v = std::is_same_v <std::decay_t<T>, ansi_style>;
+
+  // is_sink
+  /**
+   * @brief Struct used to check if a type is an output sink (ex: ptc::FileSink). Sinks are specialized in their own headers; they must provide a "write( std::string_view line, bool flush_val )" method, which is called with each whole formatted print call.
+   * 
+   * @tparam T The type to be checked.
+   */
+  template <class T>
+  struct is_sink: std::false_type {};
+
+  template <class T>
+  inline constexpr bool is_sink_v = is_sink <std::remove_cv_t <std::remove_reference_t<T>>>::value;
+
+  // is_character
+  /**
+   * @brief Struct used to define a type trait for narrow character types, which are printed as characters and not as numbers.
+   * 
+   * @tparam T 
+   */
+  template <class T>
+  inline constexpr bool is_character_v = std::is_same_v <T, char> || std::is_same_v <T, signed char> || std::is_same_v <T, unsigned char>;
+
+  // is_wide_character
+  /**
+   * @brief Struct used to define a type trait for wide character types, which are always inserted through the output stream.
+   * 
+   * @tparam T 
+   */
+  template <class T>
+  inline constexpr bool is_wide_character_v = std::is_same_v <T, wchar_t> || std::is_same_v <T, char16_t> || std::is_same_v <T, char32_t>
+  #ifdef __cpp_char8_t
+   || std::is_same_v <T, char8_t>
+  #endif
+   ;
+
+  // is_complex
+  /**
+   * @brief Struct used to define a type trait for std::complex.
+   * 
+   * @tparam T 
+   */
+  template <class T>
+  struct is_complex: std::false_type {};
+
+  template <class T>
+  struct is_complex <std::complex <T>>: std::true_type {};
+
+  template <class T>
+  inline constexpr bool is_complex_v = is_complex<T>::value;
+
+  // is_pair
+  /**
+   * @brief Struct used to define a type trait for std::pair.
+   * 
+   * @tparam T 
+   */
+  template <class T>
+  struct is_pair: std::false_type {};
+
+  template <class T, class U>
+  struct is_pair <std::pair <T, U>>: std::true_type {};
+
+  template <class T>
+  inline constexpr bool is_pair_v = is_pair<T>::value;
+
+  // is_container
+  /**
+   * @brief Struct used to define a type trait for the containers which are printed by the operator << overload for containers (i.e. containers without an already existing operator << overload).
+   * 
+   * @tparam T 
+   */
+  template <class T>
+  struct is_container: std::false_type {};
+
+  template <template <typename, typename...> class ContainerType, typename ValueType, typename... Args>
+  struct is_container <ContainerType <ValueType, Args...>>: std::bool_constant< ! is_streamable_v <ContainerType <ValueType, Args...>> && ! is_pair_v <ContainerType <ValueType, Args...>>> {};
+
+  template <class T>
+  inline constexpr bool is_container_v = is_container<T>::value;
+
+  // is_c_array
+  /**
+   * @brief Struct used to define a type trait for the C arrays printed by the operator << overload for C arrays (i.e. non-char arrays).
+   * 
+   * @tparam T 
+   */
+  template <class T>
+  inline constexpr bool is_c_array_v = std::is_array_v <T> && std::extent_v <T> != 0 && ! std::is_same_v <std::remove_cv_t<std::remove_extent_t<T>>, char>;
+
+  // float_to_chars
+  /**
+   * @brief Constant used to check if std::to_chars supports floating-point types in the current standard library.
+   * 
+   */
+  #if defined( __cpp_lib_to_chars ) && __cpp_lib_to_chars >= 201611L
+   inline constexpr bool float_to_chars = true;
+  #else
+   inline constexpr bool float_to_chars = false;
+  #endif
+
+  // is_number
+  /**
+   * @brief Constant used to check if a type is printed as a number (i.e. arithmetic types except characters and bool).
+   * 
+   * @tparam T 
+   */
+  template <class T>
+  inline constexpr bool is_number_v = std::is_arithmetic_v <T> && ! std::is_same_v <T, bool> && ! is_character_v <T> && ! is_wide_character_v <T>;
+
+  // is_numeric_range
+  /**
+   * @brief Struct used to define a type trait for the contiguous ranges of numbers (ex: std::vector<int>, std::array<double, N>, C arrays or span-like types with data() and size() methods) without an already existing operator << overload.
+   * 
+   * @tparam T 
+   */
+  template <class T, class = void>
+  struct is_numeric_range: std::false_type {};
+
+  template <class T>
+  struct is_numeric_range <T, std::void_t <decltype( std::data( std::declval <const T&>() ) ), decltype( std::size( std::declval <const T&>() ) )>>: 
+   std::bool_constant< std::is_pointer_v <decltype( std::data( std::declval <const T&>() ) )> && 
+                       is_number_v <std::remove_cv_t <std::remove_pointer_t <decltype( std::data( std::declval <const T&>() ) )>>> && 
+                       ! is_streamable_v <T>> {};
+
+  template <class T>
+  inline constexpr bool is_numeric_range_v = is_numeric_range<T>::value;
+
   //====================================================
   //     Operator << overloads
   //====================================================
 
+  // Overload for ptc::ansi_style
+  /**
+   * @brief Operator << overload for ptc::ansi_style printing.
+   * 
+   * @param os The type of the output stream.
+   * @param style The style to be printed.
+   * @return std::ostream& The stream to which the style is printed to.
+   */
+  inline std::ostream& operator << ( std::ostream& os, const ansi_style& style )
+   {
+    return os << style.code;
+   }
+
   // Overload for std::complex
   /**
    * @brief Operator << overload for std::complex printing.
@@ -165,281 +398,2363 @@ namespace ptc
    }
 
   //====================================================
-  //     ptc_print class
+  //     Formatting tools
   //====================================================
+
+  // string_appender
   /**
-   * @brief Class used to construct the print function.
+   * @brief Stream buffer used to append the formatted output directly at the end of an std::string object. Single characters are collected into a small put area which is moved into the string when it is full or when the buffer is synchronized.
    * 
    */
-  struct Print
+  class string_appender: public std::streambuf
    {
-     //====================================================
-     //     Public constructors and destructor
-     //====================================================
+    public:
 
-     // Default constructor
+     // Constructor
      /**
-      * @brief Default constructor of the Print class. It initializes the basic class members and enable (if required) performance improvements..
+      * @brief Construct a new string_appender object.
       * 
+      * @param target The string to which the output is appended.
       */
-     Print(): end( "\n" ), sep( " " ), flush( false ) 
+     explicit string_appender( std::string* target ): target_( target ) 
       {
-       #ifdef PTC_ENABLE_PERFORMANCE_IMPROVEMENTS
-        performance_options();
-       #endif
+       setp( chunk_, chunk_ + chunk_size );
       }
 
-     //====================================================
-     //     Public setters
-     //====================================================
+    protected:
 
-     // setEnd
+     // overflow
      /**
-      * @brief Setter used to set the value of the "end" variable. Templated type is required in order to allow also char variables.
+      * @brief Method used to move the put area into the target string and to append a single character to it.
       * 
-      * @tparam T The type of the expression inserted to set the value of "end" variable.
-      * @param end_val The inserted expression used to set the value of "end" variable.
+      * @param c The character to be appended.
+      * @return int_type The appended character, or eof in case of failure.
       */
-     template <class T> 
-     inline void setEnd( const T& end_val )
+     int_type overflow( int_type c ) override
       {
-       end = end_val;
+       drain();
+       if ( traits_type::eq_int_type( c, traits_type::eof() ) ) return traits_type::not_eof( c );
+       *pptr() = traits_type::to_char_type( c );
+       pbump( 1 );
+       return c;
       }
 
-     // setSep
+     // xsputn
      /**
-      * @brief Setter used to set the value of the "sep" variable. Templated type is required in order to allow also char variables.
+      * @brief Method used to append a sequence of characters to the target string.
       * 
-      * @tparam T The type of the expression inserted to set the value of "sep" variable.
-      * @param end_val The inserted expression used to set the value of "sep" variable.
+      * @param s The sequence of characters.
+      * @param n The length of the sequence.
+      * @return std::streamsize The number of appended characters.
       */
-     template <class T>
-     inline void setSep( const T& sep_val )
+     std::streamsize xsputn( const char* s, std::streamsize n ) override
       {
-       sep = sep_val;
+       drain();
+       target_ -> append( s, static_cast <std::size_t> ( n ) );
+       return n;
       }
 
-     // setFlush
+     // sync
      /**
-      * @brief Setter used to set the value of the "flush" variable. Templated type is required in order to allow also char variables.
-      * 
+      * @brief Method used to move the put area into the target string.
       * 
-      * @param flush_val The inserted expression used to set the value of the "flush" variable.
+      * @return int Always 0.
       */
-     inline void setFlush( const bool& flush_val )
+     int sync() override
       {
-       flush = flush_val;
+       drain();
+       return 0;
       }
 
-     //====================================================
-     //     Public getters
-     //====================================================
+    private:
 
-     // getEnd
+     // drain
      /**
-      * @brief Getter used to get the value of the "end" variable. Mainly used for debugging.
+      * @brief Method used to move the content of the put area into the target string.
       * 
-      * @return auto The value of the "end" variable.
       */
-     inline const auto& getEnd() const 
+     void drain()
       {
-       return end;
+       target_ -> append( pbase(), static_cast <std::size_t> ( pptr() - pbase() ) );
+       setp( chunk_, chunk_ + chunk_size );
       }
 
-     // getSep
+     static constexpr std::size_t chunk_size = 128;
+     std::string* target_;
+     char chunk_[ chunk_size ];
+   };
+
+  // format_buffer
+  /**
+   * @brief Class used to store the buffer in which a single print call is formatted before being committed to the output stream. Each thread owns one of these buffers, therefore formatting never requires a lock. Strings, characters and arithmetic types (also inside std::complex, std::pair, containers and C arrays) are written directly into the buffer, numbers are converted with std::to_chars (shortest round-trip representation for floating-point types). All the other types are inserted through an std::ostream which writes into the same buffer.
+   * 
+   */
+  class format_buffer
+   {
+    public:
+
+     // Constructor
      /**
-      * @brief Getter used to get the value of the "sep" variable. Mainly used for debugging.
+      * @brief Construct a new format_buffer object.
       * 
-      * @return auto The value of the "sep" variable.
       */
-     inline const auto& getSep() const
-      {
-       return sep;
-      }
+     format_buffer(): appender_( &data_ ), stream_( &appender_ ) {}
 
-     // getFlush
+     format_buffer( const format_buffer& ) = delete;
+     format_buffer& operator =( const format_buffer& ) = delete;
+
+     // data
      /**
-      * @brief Getter used to get the value of the "flush" variable. Mainly used for debugging.
+      * @brief Getter used to get the formatted content of the buffer.
       * 
-      * @return bool The value of the "flush" variable.
+      * @return std::string& The formatted content.
       */
-     inline const bool& getFlush() const
-      {
-       return flush;
-      }
-
-     //====================================================
-     //     Public operator () overloads
-     //====================================================
+     std::string& data() { return data_; }
 
-     // General case
+     // copy_format
      /**
-      * @brief Frontend implementation of the () operator overload to print to the output stream. The backend implementation is called in the required variation.
+      * @brief Method used to copy the formatting state of the target stream into the buffer stream, so that manipulators applied to the target stream (ex: std::setprecision) are still honoured. Only read-only accessors are used unless a field width is pending, since the calling thread does not hold the stream lock yet. Fast formatting is used only if the target stream has the default formatting state and a locale which neither groups digits nor changes the decimal point.
       * 
-      * @tparam T Generic type of first object to be passed as argument to the backend implementation.
-      * @tparam Args Generic type of all the other objects to be passed to the backend implementation.
-      * @param first First object to be passed to the backend implementation.
-      * @param args The list of all the other objects to be passed to the backend implementation.
+      * @param os The target stream.
+      * @param fast_val If false, all the arguments are inserted through the buffer stream.
       */
-     template <class T, class... Args>
-     void operator()( T&& first, Args&&... args ) const
+     void copy_format( std::ostream& os, bool fast_val )
       {
-       if constexpr ( std::is_base_of_v <std::ostream, std::remove_reference_t<T>> ||
-                      std::is_base_of_v <std::wostream, std::remove_reference_t<T>> )
-        {
-         print_backend( std::forward<T>( first ), std::forward<Args>( args )... );
-        }
-       else
+       target_ = &os;
+       locale_ready_ = false;
+       stream_.flags( os.flags() );
+       stream_.precision( os.precision() );
+       if ( os.width() )
         {
-         print_backend( std::cout, std::forward<T>( first ), std::forward<Args>( args )... );
+         stream_.fill( os.fill() );
+         stream_.width( os.width() );
+         os.width( 0 );
         }
+       fast_ = fast_val && stream_.flags() == default_flags && stream_.precision() == default_precision && stream_.width() == 0 && plain_numbers( os.getloc() );
       }
 
-     // String initialization case
+     // setFast
      /**
-      * @brief Frontend implementation of the () operator overload to initialize its content with an std::string object. The backend implementation is called in the required variation. This overload is required in order to hide the output of the "print_backend" function during the initialization.
+      * @brief Setter used to enable or disable the fast formatting when there is no target stream (ex: mode::str). As for a target stream, fast formatting is used only if the global locale neither groups digits nor changes the decimal point.
       * 
-      * @tparam Args Generic type of all the other objects to be passed to the backend implementation.
-      * @param first First object to be passed to the backend implementation.
-      * @param args The list of all the other objects to be passed to the backend implementation.
-      * @return const std::string The whole print content in std::string format.
+      * @param fast_val The value of the fast formatting flag.
       */
-     template <class... Args>
-     const std::string operator()( mode&& first, Args&&... args ) const
+     void setFast( bool fast_val ) 
       { 
-       if constexpr( sizeof...( args ) > 0 )
-        {
-         switch( first )
-          {
-           case mode::str:
-            {
-             std::ostringstream oss;
-             print_backend( oss, std::forward<Args>( args )... );
-             return oss.str();
-            }
-          }
-        }
-       return "";
+       fast_ = fast_val && plain_numbers( std::locale() ); 
       }
 
-     // No arguments case
+     // getFast
      /**
-      * @brief Template operator redefinition used to print an empty line on the screen. This is the no argument case overload. Can be used with "ptc::print()" or "ptc::print( ostream_name )".
+      * @brief Getter used to check if the fast formatting is enabled.
       * 
-      * @param os The stream in which you want to print the output.
+      * @return bool The value of the fast formatting flag.
       */
-     void operator () ( std::ostream& os = std::cout ) const
-      {
-       os << getEnd();
-       if ( getFlush() ) os << std::flush;
+     bool getFast() const 
+      { 
+       return fast_; 
       }
-     
-    private:
 
-     //====================================================
-     //     Private structs
-     //====================================================
-
-     // null_string
+     // setLimits
      /**
-      * @brief Struct used to define the "null_str" constant. This workaround is needed for correct compilation in both gcc and clang.
+      * @brief Setter used to truncate the printed containers.
       * 
-      * @tparam T The template parameter of the future "null_string" constant.
+      * @param max_items The maximum number of elements printed for each container, 0 for no limit.
+      * @param max_depth The maximum number of nested container levels printed, 0 for no limit.
       */
-     template <class T> 
-     struct null_string
-      {
-       inline static const std::string value = "";
-      };
+     void setLimits( std::size_t max_items, std::size_t max_depth ) 
+      { 
+       max_items_ = max_items;
+       max_depth_ = max_depth;
+      }
 
-     //====================================================
-     //     Private methods
-     //====================================================
+     // setParallel
+     /**
+      * @brief Setter used to set the number of threads used to format large containers. Parallel formatting is available only if the "ptc/parallel_print.hpp" header is included, otherwise containers are formatted sequentially.
+      * 
+      * @param threads The number of threads, 0 or 1 to disable parallel formatting.
+      */
+     void setParallel( unsigned threads ) 
+      { 
+       threads_ = threads;
+      }
 
-     // is_escape
+     // setChunkWriter
      /**
-      * @brief This method is used to check if an input variable is an ANSI escape sequency or not.
+      * @brief Setter used to commit the buffer in chunks while large containers are written, so that huge print calls are not materialized in memory. The writer must stay alive until the end of the call.
       * 
-      * @tparam T Template type of the input variable.
-      * @param str The input variable.
-      * @param flag A flag which let to return different things with respect to its value. If flag = 0 the ANSI is searched as the first substring of the str argument, otherwise, if flag = 1 the ANSI is searched as a substring inside the str argument.
-      * @return true If the input variable is an ANSI escape sequency.
-      * @return false Otherwise.
+      * @tparam F The type of the writer, callable with an std::string_view.
+      * @param writer The writer which receives each chunk.
       */
-     template <typename T>
-     static constexpr bool is_escape( const T& str, ANSI&& flag )
-      {
-       if constexpr( std::is_convertible_v <T, std::string_view> && ! std::is_same_v<T, std::nullptr_t> )
-        {
-         switch( flag )
-          {
-           case( ANSI::first ): 
-            {
-             return ( ! std::string_view( str ).rfind( "\033", 0 ) ) && ( std::string_view( str ).length() < 7 );
-            }
-           case( ANSI::generic ):
-            {
-             return ( std::string_view( str ).find( "\033" ) != std::string_view::npos );
-            }
-          }
-        }
-       return false;
+     template <class F>
+     void setChunkWriter( F& writer ) 
+      { 
+       chunk_target_ = &writer;
+       chunk_write_ = []( void* target, std::string_view chunk ){ ( *static_cast <F*> ( target ) )( chunk ); };
       }
 
-     // is_null_str
+     // append
      /**
-      * @brief This method is used to check if an input variable is a null string or not.
+      * @brief Method used to append a sequence of characters to the buffer.
       * 
-      * @tparam T The templated type of the input variable.
-      * @param str The input variable.
-      * @return true If the variable is a null string.
-      * @return false Otherwise.
+      * @param str The sequence of characters.
       */
-     template <typename T>
-     static constexpr bool is_null_str( const T& str )
+     void append( std::string_view str )
       {
-       if constexpr( std::is_convertible_v <T, std::string_view> )
-        {
-         return str == null_str <T>;
-        }
-       return false;
+       data_.append( str.data(), str.size() );
       }
-      
-     // print_backend
+
+     // write
      /**
-      * @brief Backend implementation of the () operator overloads to print to the output stream. The stream is automatically reset in case of an ANSI escape sequence is sent to output.
+      * @brief Method used to write an object into the buffer.
       * 
-      * @tparam T_os The type of the output stream object.
-      * @tparam T Generic type of first object to be printed.
-      * @tparam Args Generic type of all the other objects to be printed.
-      * @param os The stream in which you want to print the output.
-      * @param first First printed object.
-      * @param args The list of objects to be printed on the screen.
+      * @tparam T The type of the object.
+      * @param x The object to be written.
       */
-     template <class T_os, class T, class... Args>
-     void print_backend( T_os&& os, T&& first, Args&&... args ) const
+     template <class T>
+     void write( const T& x )
       {
-       std::lock_guard <std::mutex> lock{ mutex_ };
- 
-       // Printing all the arguments
-       os << first;
-       if constexpr( sizeof...( args ) > 0 ) 
+       if constexpr( is_string_like_v <T> )
         {
-         if ( is_null_str( first ) || is_escape( first, ANSI::first ) ) ( ( os << args << getSep() ), ...); 
-         else ( ( os << getSep() << args ), ...);
+         if ( ! fast_ ) insert( x );
+         else if constexpr( std::is_pointer_v <T> ) 
+          {
+           if ( x ) data_.append( x );
+          }
+         else data_.append( std::string_view( x ) );
         }
-       os << getEnd();
-
-       // Resetting the stream from ANSI escape sequences
-       if constexpr( sizeof...( args ) > 0 )
+       else if constexpr( std::is_same_v <T, std::nullptr_t> ) insert( x );
+       else if constexpr( is_style_v <T> ) append( x.code );
+       else if constexpr( is_character_v <T> )
         {
-         if ( is_escape( first, ANSI::generic ) || ( ( is_escape( args, ANSI::generic ) ) || ...) ) os << reset_ANSI;
+         if ( fast_ ) data_.push_back( static_cast <char> ( x ) );
+         else insert( x );
         }
-       else 
+       else if constexpr( std::is_same_v <T, bool> )
         {
-        if ( is_escape( first, ANSI::generic ) ) os << reset_ANSI;
+         if ( fast_ ) data_.push_back( x ? '1' : '0' );
+         else insert( x );
+        }
+       else if constexpr( std::is_integral_v <T> && ! is_wide_character_v <T> )
+        {
+         if ( fast_ ) write_chars( x );
+         else insert( x );
+        }
+       else if constexpr( std::is_floating_point_v <T> && float_to_chars )
+        {
+         if ( fast_ ) write_chars( x );
+         else insert( x );
+        }
+       else if constexpr( is_complex_v <T> )
+        {
+         if ( fast_ )
+          {
+           write( x.real() );
+           data_.push_back( '+' );
+           write( x.imag() );
+           data_.push_back( 'j' );
+          }
+         else insert( x );
+        }
+       else if constexpr( is_pair_v <T> )
+        {
+         if ( fast_ )
+          {
+           data_.push_back( '[' );
+           write( x.first );
+           data_.append( ", ", 2 );
+           write( x.second );
+           data_.push_back( ']' );
+          }
+         else insert( x );
+        }
+       else if constexpr( is_numeric_range_v <T> ) write_range( std::data( x ), std::data( x ) + std::size( x ) );
+       else if constexpr( is_container_v <T> || is_c_array_v <T> ) write_range( std::begin( x ), std::end( x ) );
+       else insert( x );
+      }
+
+     // lease
+     /**
+      * @brief Class used to borrow the buffer of the current thread for the duration of a print call.
+      * 
+      */
+     class lease;
+
+    private:
+
+     // write_chars
+     /**
+      * @brief Method used to write an arithmetic value into the buffer with std::to_chars.
+      * 
+      * @tparam T The type of the value.
+      * @param x The value.
+      */
+     template <class T>
+     void write_chars( T x )
+      {
+       char chars[ 64 ];
+       const auto result = std::to_chars( chars, chars + sizeof( chars ), x );
+       data_.append( chars, static_cast <std::size_t> ( result.ptr - chars ) );
+      }
+
+     // write_range
+     /**
+      * @brief Method used to write a range of elements in the "[a, b, c]" format. Ranges beyond the maximum number of elements or the maximum depth are truncated with a "..." marker. Large random-access ranges are formatted by several threads if parallel formatting is enabled.
+      * 
+      * @tparam It The iterator type.
+      * @param first The beginning of the range.
+      * @param last The end of the range.
+      */
+     template <class It>
+     void write_range( It first, It last )
+      {
+       if ( fast_ ) data_.push_back( '[' );
+       else insert( '[' );
+       if ( max_depth_ && depth_ >= max_depth_ )
+        {
+         if ( first != last ) data_.append( "...", 3 );
+         data_.push_back( ']' );
+         return;
+        }
+
+       ++depth_;
+       if constexpr( std::is_base_of_v <std::random_access_iterator_tag, typename std::iterator_traits <It>::iterator_category> )
+        {
+         const auto n = static_cast <std::size_t> ( last - first );
+         const std::size_t shown = max_items_ ? std::min( n, max_items_ ) : n;
+         if ( threads_ > 1 && parallel_run_ && fast_ && shown >= parallel_min ) write_parallel( first, first + shown );
+         else write_elements( first, first + shown );
+         if ( shown < n ) data_.append( ", ...", 5 );
+        }
+       else
+        {
+         for ( std::size_t count = 0; first != last; ++first, ++count )
+          {
+           if ( count ) data_.append( ", ", 2 );
+           if ( max_items_ && count == max_items_ )
+            {
+             data_.append( "...", 3 );
+             break;
+            }
+           write( *first );
+           commit_chunk();
+          }
+        }
+       --depth_;
+       data_.push_back( ']' );
+      }
+
+     // write_elements
+     /**
+      * @brief Method used to write a range of elements in the "a, b, c" format, without brackets. Contiguous ranges of numbers are converted in blocks.
+      * 
+      * @tparam It The iterator type.
+      * @param first The beginning of the range.
+      * @param last The end of the range.
+      */
+     template <class It>
+     void write_elements( It first, It last )
+      {
+       using value_type = std::remove_cv_t <typename std::iterator_traits <It>::value_type>;
+       if constexpr( std::is_pointer_v <It> && is_number_v <value_type> && ( std::is_integral_v <value_type> || float_to_chars ) )
+        {
+         if ( fast_ )
+          {
+           write_numbers( first, static_cast <std::size_t> ( last - first ) );
+           return;
+          }
+        }
+       for ( It it = first; it != last; ++it )
+        {
+         if ( it != first ) data_.append( ", ", 2 );
+         write( *it );
+         commit_chunk();
+        }
+      }
+
+     // write_numbers
+     /**
+      * @brief Method used to write a contiguous range of numbers in the "a, b, c" format. Numbers are converted in blocks directly into the buffer, which is resized once per block, and integers are converted eight digits at a time with SSE2 (if available).
+      * 
+      * @tparam T The type of the numbers.
+      * @param first The first number.
+      * @param n The number of elements.
+      */
+     template <class T>
+     void write_numbers( const T* first, std::size_t n )
+      {
+       constexpr std::size_t max_chars = std::is_integral_v <T> ? std::numeric_limits <T>::digits10 + 3 : 48;
+       for ( std::size_t begin = 0; begin < n; begin += numbers_block )
+        {
+         const std::size_t count = std::min( numbers_block, n - begin );
+         const std::size_t size = data_.size();
+         data_.resize( size + count * ( max_chars + 2 ) );
+         char* out = data_.data() + size;
+         for ( std::size_t i = begin; i < begin + count; ++i )
+          {
+           if ( i )
+            {
+             out[ 0 ] = ',';
+             out[ 1 ] = ' ';
+             out += 2;
+            }
+           if constexpr( std::is_integral_v <T> ) out = write_integer( out, first[ i ] );
+           else out = std::to_chars( out, out + max_chars, first[ i ] ).ptr;
+          }
+         data_.resize( static_cast <std::size_t> ( out - data_.data() ) );
+         commit_chunk();
+        }
+      }
+
+     // write_parallel
+     /**
+      * @brief Method used to write a large random-access range of elements in the "a, b, c" format with several threads. The range is formatted in rounds: in each round the parts of "parallel_part" elements are formatted concurrently (by the runner installed by "ptc/parallel_print.hpp") into their own buffers, and they are appended in order, therefore the output is identical to the sequential one and the memory usage stays bounded.
+      * 
+      * @tparam It The iterator type.
+      * @param first The beginning of the range.
+      * @param last The end of the range.
+      */
+     template <class It>
+     void write_parallel( It first, It last )
+      {
+       const auto n = static_cast <std::size_t> ( last - first );
+       std::vector <std::string> parts;
+       for ( std::size_t begin = 0; begin < n; )
+        {
+         const std::size_t round = std::min( n - begin, parallel_part * threads_ );
+         parts.assign( ( round + parallel_part - 1 ) / parallel_part, std::string() );
+         auto format_part = [ this, first, begin, round, &parts ]( std::size_t part )
+          {
+           format_buffer part_buffer;
+           part_buffer.setLimits( max_items_, max_depth_ );
+           part_buffer.depth_ = depth_;
+           part_buffer.write_elements( first + ( begin + part * parallel_part ), first + ( begin + std::min( round, ( part + 1 ) * parallel_part ) ) );
+           parts[ part ] = std::move( part_buffer.data_ );
+          };
+         parallel_run_( []( void* context, std::size_t part ){ ( *static_cast <decltype( format_part )*> ( context ) )( part ); }, &format_part, parts.size() );
+
+         // Appending the parts in order
+         for ( auto& part: parts )
+          {
+           if ( begin || &part != &parts.front() ) data_.append( ", ", 2 );
+           data_.append( part );
+           commit_chunk();
+          }
+         begin += round;
+        }
+      }
+
+     // commit_chunk
+     /**
+      * @brief Method used to commit the buffer to the chunk writer (if any) once it is larger than "chunk_size" bytes.
+      * 
+      */
+     void commit_chunk()
+      {
+       if ( chunk_write_ && data_.size() >= chunk_size )
+        {
+         chunk_write_( chunk_target_, data_ );
+         data_.clear();
+        }
+      }
+
+     // write_integer
+     /**
+      * @brief Method used to write an integer into a character array large enough to contain it.
+      * 
+      * @tparam T The type of the integer.
+      * @param out The character array.
+      * @param x The integer.
+      * @return char* The position past the last written character.
+      */
+     template <class T>
+     static char* write_integer( char* out, T x )
+      {
+       std::uint64_t value = static_cast <std::uint64_t> ( x );
+       if constexpr( std::is_signed_v <T> )
+        {
+         if ( x < 0 )
+          {
+           *out++ = '-';
+           value = 0 - value;
+          }
+        }
+
+       #ifdef PTC_SSE2
+        constexpr std::uint64_t e8 = 100000000, e16 = e8 * e8;
+        alignas( 16 ) char digits[ 16 ];
+        if ( value < 10 )
+         {
+          *out = static_cast <char> ( '0' + value );
+          return out + 1;
+         }
+        if ( value >= e16 )
+         {
+          out = std::to_chars( out, out + 4, value / e16 ).ptr;
+          value %= e16;
+          store_digits( digits, static_cast <std::uint32_t> ( value / e8 ), static_cast <std::uint32_t> ( value % e8 ) );
+          std::memcpy( out, digits, 16 );
+          return out + 16;
+         }
+        if ( value >= e8 )
+         {
+          const auto high = static_cast <std::uint32_t> ( value / e8 );
+          store_digits( digits, high, static_cast <std::uint32_t> ( value % e8 ) );
+          const std::size_t length = 8 + count_digits( high );
+          std::memcpy( out, digits + 16 - length, length );
+          return out + length;
+         }
+        store_digits( digits, 0, static_cast <std::uint32_t> ( value ) );
+        const std::size_t length = count_digits( static_cast <std::uint32_t> ( value ) );
+        std::memcpy( out, digits + 16 - length, length );
+        return out + length;
+       #else
+        return std::to_chars( out, out + 24, value ).ptr;
+       #endif
+      }
+
+     #ifdef PTC_SSE2
+
+     // convert_digits
+     /**
+      * @brief Method used to convert a number lower than 10^8 into its eight decimal digits, stored in the 16-bit lanes of an SSE2 register. Divisions are replaced by multiplications by fixed-point reciprocals.
+      * 
+      * @param value The number.
+      * @return __m128i The digits, from the most significant one.
+      */
+     static __m128i convert_digits( std::uint32_t value )
+      {
+       // abcd, efgh = abcdefgh divmod 10000
+       const __m128i abcdefgh = _mm_cvtsi32_si128( static_cast <int> ( value ) );
+       const __m128i abcd = _mm_srli_epi64( _mm_mul_epu32( abcdefgh, _mm_set1_epi32( static_cast <int> ( 0xd1b71759 ) ) ), 45 );
+       const __m128i efgh = _mm_sub_epi32( abcdefgh, _mm_mul_epu32( abcd, _mm_set1_epi32( 10000 ) ) );
+
+       // [ abcd * 4 ] x 4, [ efgh * 4 ] x 4
+       const __m128i v1 = _mm_slli_epi64( _mm_unpacklo_epi16( abcd, efgh ), 2 );
+       const __m128i v2 = _mm_unpacklo_epi32( _mm_unpacklo_epi16( v1, v1 ), _mm_unpacklo_epi16( v1, v1 ) );
+
+       // [ a, ab, abc, abcd, e, ef, efg, efgh ]
+       const __m128i v3 = _mm_mulhi_epu16( v2, _mm_setr_epi16( 8389, 5243, 13108, -32768, 8389, 5243, 13108, -32768 ) );
+       const __m128i v4 = _mm_mulhi_epu16( v3, _mm_setr_epi16( 1 << 7, 1 << 11, 1 << 13, -32768, 1 << 7, 1 << 11, 1 << 13, -32768 ) );
+
+       // [ a, b, c, d, e, f, g, h ]
+       return _mm_sub_epi16( v4, _mm_slli_epi64( _mm_mullo_epi16( v4, _mm_set1_epi16( 10 ) ), 16 ) );
+      }
+
+     // store_digits
+     /**
+      * @brief Method used to store the sixteen decimal digits of two numbers lower than 10^8 as characters.
+      * 
+      * @param digits The output characters.
+      * @param high The number of the first eight digits.
+      * @param low The number of the last eight digits.
+      */
+     static void store_digits( char* digits, std::uint32_t high, std::uint32_t low )
+      {
+       const __m128i packed = _mm_packus_epi16( convert_digits( high ), convert_digits( low ) );
+       _mm_store_si128( reinterpret_cast <__m128i*> ( digits ), _mm_add_epi8( packed, _mm_set1_epi8( '0' ) ) );
+      }
+
+     // count_digits
+     /**
+      * @brief Method used to count the decimal digits of a number lower than 10^8.
+      * 
+      * @param value The number.
+      * @return std::size_t The number of digits.
+      */
+     static std::size_t count_digits( std::uint32_t value )
+      {
+       return 1 + ( value >= 10 ) + ( value >= 100 ) + ( value >= 1000 ) + ( value >= 10000 ) + ( value >= 100000 ) + ( value >= 1000000 ) + ( value >= 10000000 );
+      }
+
+     #endif
+
+     // insert
+     /**
+      * @brief Method used to insert an object into the buffer through the buffer stream. The locale of the target stream, or the global locale if there is no target stream, is copied the first time the buffer stream is used.
+      * 
+      * @tparam T The type of the object.
+      * @param x The object to be inserted.
+      */
+     template <class T>
+     void insert( const T& x )
+      {
+       if ( ! locale_ready_ )
+        {
+         const std::locale loc = target_ ? target_ -> getloc() : std::locale();
+         if ( stream_.getloc() != loc ) stream_.imbue( loc );
+         locale_ready_ = true;
+        }
+       stream_ << x;
+       appender_.pubsync();
+      }
+
+     // plain_numbers
+     /**
+      * @brief Method used to check if a locale writes numbers as std::to_chars does, i.e. without digits grouping and with "." as decimal point. The result is cached for the last checked locale.
+      * 
+      * @param loc The locale of the target stream.
+      * @return true If numbers can be written with std::to_chars.
+      * @return false Otherwise.
+      */
+     bool plain_numbers( const std::locale& loc )
+      {
+       if ( loc != locale_ )
+        {
+         const auto& punct = std::use_facet <std::numpunct <char>>( loc );
+         plain_locale_ = punct.grouping().empty() && punct.decimal_point() == '.';
+         locale_ = loc;
+        }
+       return plain_locale_;
+      }
+
+     static constexpr std::ios_base::fmtflags default_flags = std::ios_base::dec | std::ios_base::skipws;
+     static constexpr std::streamsize default_precision = 6;
+     std::string data_;
+     string_appender appender_;
+     std::ostream stream_;
+     std::ostream* target_ = nullptr;
+     bool in_use_ = false, fast_ = true, plain_locale_ = true, locale_ready_ = false;
+     std::locale locale_ = std::locale::classic();
+     std::size_t max_items_ = 0, max_depth_ = 0, depth_ = 0;
+     unsigned threads_ = 1;
+     void* chunk_target_ = nullptr;
+     void ( *chunk_write_ )( void*, std::string_view ) = nullptr;
+     static constexpr std::size_t chunk_size = 1 << 16;
+     static constexpr std::size_t numbers_block = 1024;
+     static constexpr std::size_t parallel_min = 1 << 16, parallel_part = 1 << 15;
+     static inline void ( *parallel_run_ )( void ( * )( void*, std::size_t ), void*, std::size_t ) = nullptr;
+
+     friend struct parallel_runner;
+   };
+
+  // format_buffer::lease
+  /**
+   * @brief Class used to borrow the buffer of the current thread for the duration of a print call. In case of nested print calls (ex: a user-defined operator << which calls ptc::print) a temporary buffer is used instead.
+   * 
+   */
+  class format_buffer::lease
+   {
+    public:
+     lease()
+      {
+       thread_local format_buffer thread_buffer;
+       if ( ! thread_buffer.in_use_ ) buffer_ = &thread_buffer;
+       else buffer_ = &local_.emplace();
+       buffer_ -> in_use_ = true;
+       buffer_ -> data_.clear();
+       buffer_ -> target_ = nullptr;
+       buffer_ -> locale_ready_ = false;
+       buffer_ -> fast_ = true;
+       buffer_ -> max_items_ = buffer_ -> max_depth_ = buffer_ -> depth_ = 0;
+       buffer_ -> threads_ = 1;
+       buffer_ -> chunk_write_ = nullptr;
+       buffer_ -> stream_.clear();
+       buffer_ -> stream_.flags( default_flags );
+       buffer_ -> stream_.precision( default_precision );
+       buffer_ -> stream_.fill( ' ' );
+       buffer_ -> stream_.width( 0 );
+      }
+
+     ~lease()
+      {
+       buffer_ -> in_use_ = false;
+       if ( buffer_ -> data_.capacity() > max_kept_capacity ) std::string().swap( buffer_ -> data_ );
+      }
+
+     lease( const lease& ) = delete;
+     lease& operator =( const lease& ) = delete;
+
+     format_buffer& operator *() const { return *buffer_; }
+     format_buffer* operator ->() const { return buffer_; }
+
+    private:
+     static constexpr std::size_t max_kept_capacity = 1 << 20;
+     std::optional <format_buffer> local_;
+     format_buffer* buffer_;
+   };
+
+  //====================================================
+  //     Output targets
+  //====================================================
+
+  // string_target
+  /**
+   * @brief Struct used to print into a caller-provided std::string. The previous content of the string is replaced, but its capacity is reused.
+   * 
+   */
+  struct string_target
+   {
+    std::string& str;
+   };
+
+  // iterator_target
+  /**
+   * @brief Struct used to print into an output iterator, without any size limit.
+   * 
+   * @tparam OutputIt The type of the output iterator.
+   */
+  template <class OutputIt>
+  struct iterator_target
+   {
+    OutputIt out;
+   };
+
+  // bounded_target
+  /**
+   * @brief Struct used to print at most "n" characters into an output iterator (ex: a char* buffer).
+   * 
+   * @tparam OutputIt The type of the output iterator.
+   */
+  template <class OutputIt>
+  struct bounded_target
+   {
+    OutputIt out;
+    std::size_t n;
+   };
+
+  #ifdef PTC_MEMORY_RESOURCE
+
+  // resource_target
+  /**
+   * @brief Struct used to print into a new std::pmr::string, allocated from a caller-provided memory resource.
+   * 
+   */
+  struct resource_target
+   {
+    std::pmr::memory_resource* resource;
+   };
+
+  #endif
+
+  // to_n_result
+  /**
+   * @brief Struct returned when printing into a bounded target. It contains the iterator past the last written character and the size of the whole (not truncated) output, which is greater than the given limit in case of truncation.
+   * 
+   * @tparam OutputIt The type of the output iterator.
+   */
+  template <class OutputIt>
+  struct to_n_result
+   {
+    OutputIt out;
+    std::size_t size;
+   };
+
+  // to
+  /**
+   * @brief Function used to print into a caller-provided std::string. Ex: "ptc::print( ptc::to( str ), "Key", 1 )".
+   * 
+   * @param str The target string.
+   * @return string_target The output target.
+   */
+  inline string_target to( std::string& str )
+   {
+    return { str };
+   }
+
+  // to
+  /**
+   * @brief Function used to print into an output iterator. Ex: "ptc::print( ptc::to( std::back_inserter( vec ) ), "Key", 1 )".
+   * 
+   * @tparam OutputIt The type of the output iterator.
+   * @param out The output iterator.
+   * @return iterator_target <OutputIt> The output target.
+   */
+  template <class OutputIt>
+  inline iterator_target <OutputIt> to( OutputIt out )
+   {
+    return { out };
+   }
+
+  // to
+  /**
+   * @brief Function used to print at most "n" characters into an output iterator. Ex: "ptc::print( ptc::to( buf, sizeof( buf ) ), "Key", 1 )". No null character is appended.
+   * 
+   * @tparam OutputIt The type of the output iterator.
+   * @param out The output iterator.
+   * @param n The maximum number of characters to be written.
+   * @return bounded_target <OutputIt> The output target.
+   */
+  template <class OutputIt>
+  inline bounded_target <OutputIt> to( OutputIt out, std::size_t n )
+   {
+    return { out, n };
+   }
+
+  #ifdef PTC_MEMORY_RESOURCE
+
+  // str_in
+  /**
+   * @brief Function used to print into a new std::pmr::string allocated from a memory resource (ex: a per-request std::pmr::monotonic_buffer_resource). Ex: "std::pmr::string str = ptc::print( ptc::str_in( arena ), "Key", 1 )".
+   * 
+   * @param resource The memory resource.
+   * @return resource_target The output target.
+   */
+  inline resource_target str_in( std::pmr::memory_resource& resource )
+   {
+    return { &resource };
+   }
+
+  #endif
+
+  //====================================================
+  //     Call options
+  //====================================================
+
+  // sep_option
+  /**
+   * @brief Struct used to override the separator for a single print call.
+   * 
+   */
+  struct sep_option
+   {
+    std::string_view value;
+   };
+
+  // end_option
+  /**
+   * @brief Struct used to override the end of the line for a single print call.
+   * 
+   */
+  struct end_option
+   {
+    std::string_view value;
+   };
+
+  // flush_option
+  /**
+   * @brief Struct used to flush the stream after a single print call.
+   * 
+   */
+  struct flush_option {};
+
+  // sep
+  /**
+   * @brief Function used to override the separator for a single print call, without modifying the print object. Ex: "ptc::print( "a", "b", ptc::sep( "*" ) )".
+   * 
+   * @param value The separator.
+   * @return sep_option The call option.
+   */
+  constexpr sep_option sep( std::string_view value )
+   {
+    return { value };
+   }
+
+  // end
+  /**
+   * @brief Function used to override the end of the line for a single print call, without modifying the print object. Ex: "ptc::print( "a", "b", ptc::end( "" ) )".
+   * 
+   * @param value The end of the line.
+   * @return end_option The call option.
+   */
+  constexpr end_option end( std::string_view value )
+   {
+    return { value };
+   }
+
+  // flush
+  /**
+   * @brief Constant used to flush the stream after a single print call. Ex: "ptc::print( "a", "b", ptc::flush )".
+   * 
+   */
+  inline constexpr flush_option flush{};
+
+  // is_option
+  /**
+   * @brief Struct used to check if a type is a call option.
+   * 
+   * @tparam T The type to be checked.
+   */
+  template <class T>
+  inline constexpr bool is_option_v = std::is_same_v <std::decay_t<T>, sep_option> || 
+                                      std::is_same_v <std::decay_t<T>, end_option> || 
+                                      std::is_same_v <std::decay_t<T>, flush_option>;
+
+  // object_indices
+  /**
+   * @brief Struct used to get the indices of the arguments of a print call which are not call options.
+   * 
+   * @tparam I The index of the first argument.
+   * @tparam Seq The indices already collected.
+   * @tparam Ts The types of the arguments.
+   */
+  template <std::size_t I, class Seq, class... Ts>
+  struct object_indices
+   {
+    using type = Seq;
+   };
+
+  template <std::size_t I, std::size_t... Is, class T, class... Ts>
+  struct object_indices <I, std::index_sequence<Is...>, T, Ts...>
+   {
+    using type = typename object_indices <I + 1, std::conditional_t <is_option_v<T>, std::index_sequence<Is...>, std::index_sequence<Is..., I>>, Ts...>::type;
+   };
+
+  //====================================================
+  //     Type-erased arguments
+  //====================================================
+
+  // arg_type
+  /**
+   * @brief Enum class used to tag the type of a type-erased print argument. A "plain_string" is a string which is known not to be empty and not to start with an ANSI escape sequence (ex: a string literal), therefore it does not need to be checked at each call.
+   * 
+   */
+  enum class arg_type: unsigned char { string, c_string, style, plain_string, character, boolean, signed_integer, unsigned_integer, single_float, double_float, long_float, object, sep, end, flush };
+
+  // erased_arg
+  /**
+   * @brief Struct used to store a type-erased print argument. Strings, characters, booleans, arithmetic values, styles and call options are stored by value and written by a single non-template function; any other object is stored by address, together with the function which writes its type.
+   * 
+   */
+  struct erased_arg
+   {
+    union
+     {
+      const void* ptr;
+      const char* str;
+      long long signed_integer;
+      unsigned long long unsigned_integer;
+      double floating;
+      char character;
+      bool boolean;
+     } value;
+    union
+     {
+      std::size_t size;
+      void ( *write )( format_buffer&, const void* );
+     } extra;
+    arg_type type;
+   };
+
+  // erased_backend
+  /**
+   * @brief Constant used to check if print calls are type-erased and sent to the non-template backend. This is the case of separate compilation, or of header-only usage with the PTC_TYPE_ERASURE macro.
+   * 
+   */
+  #if defined( PTC_SEPARATE_COMPILATION ) || defined( PTC_TYPE_ERASURE )
+   inline constexpr bool erased_backend = true;
+  #else
+   inline constexpr bool erased_backend = false;
+  #endif
+
+  //====================================================
+  //     Shared configuration
+  //====================================================
+
+  // config_cell
+  /**
+   * @brief Class used to store the configuration of a print object as an immutable snapshot. Setters publish a new snapshot, therefore each print call reads a consistent configuration without locking, while a setter runs in another thread.
+   * 
+   * @tparam T The type of the configuration.
+   */
+  template <class T>
+  class config_cell
+   {
+    public:
+
+     class snapshot;
+
+     // Default constructor
+     /**
+      * @brief Construct a new config_cell object with the default configuration.
+      * 
+      */
+     config_cell(): value_( std::make_shared <const T>() ), version_( next_version() ) {}
+
+     // Copy constructor
+     /**
+      * @brief Construct a new config_cell object which shares the current snapshot of another one.
+      * 
+      * @param other The config_cell object to be copied.
+      */
+     config_cell( const config_cell& other ): value_( other.load() ), version_( next_version() ) {}
+
+     // Copy assignment operator
+     /**
+      * @brief Copy assignment operator of the config_cell class. The current snapshot of the other object is published as a new snapshot of this object.
+      * 
+      * @param other The config_cell object to be copied.
+      * @return config_cell& The reference to this object.
+      */
+     config_cell& operator =( const config_cell& other )
+      {
+       if ( this != &other )
+        {
+         const auto other_value = other.load();
+         update( [ &other_value ]( T& config ){ config = *other_value; } );
+        }
+       return *this;
+      }
+
+     // update
+     /**
+      * @brief Method used to publish a new configuration snapshot. Writers are serialized, while readers keep using the previous snapshot until they see the new version.
+      * 
+      * @tparam F The type of the function which changes the configuration.
+      * @param change The function which changes a copy of the current configuration.
+      */
+     template <class F>
+     void update( F&& change )
+      {
+       std::lock_guard <std::mutex> lock{ mutex_ };
+       auto next = std::make_shared <T>( *load() );
+       change( *next );
+       std::atomic_store( &value_, std::shared_ptr <const T>( std::move( next ) ) );
+       version_.store( next_version(), std::memory_order_release );
+      }
+
+    private:
+
+     struct thread_cache;
+
+     // load
+     /**
+      * @brief Method used to load the current snapshot.
+      * 
+      * @return std::shared_ptr <const T> The current snapshot.
+      */
+     std::shared_ptr <const T> load() const
+      {
+       return std::atomic_load( &value_ );
+      }
+
+     // next_version
+     /**
+      * @brief Method used to get a new version number. Versions are unique among all the objects, so that the snapshots cached for a destroyed object are never reused by a new one.
+      * 
+      * @return std::uint64_t The new version number.
+      */
+     static std::uint64_t next_version()
+      {
+       static std::atomic <std::uint64_t> counter{ 0 };
+       return counter.fetch_add( 1, std::memory_order_relaxed ) + 1;
+      }
+
+     std::shared_ptr <const T> value_;
+     std::atomic <std::uint64_t> version_;
+     std::mutex mutex_;
+   };
+
+  // config_cell::snapshot
+  /**
+   * @brief Class used to read the current configuration of a config_cell object for the duration of a print call. Each thread caches the last snapshot of each object together with its version, therefore the shared snapshot (and its reference count) is touched only after a setter has published a new one. Snapshots replaced while a call of the same thread is running (ex: by a nested print call) are kept alive until the outermost call returns.
+   * 
+   * @tparam T The type of the configuration.
+   */
+  template <class T>
+  class config_cell <T>::snapshot
+   {
+    public:
+     explicit snapshot( const config_cell& cell ): cache_( thread_cache::local() )
+      {
+       ++cache_.active;
+       value_ = &cache_.get( cell );
+      }
+
+     ~snapshot()
+      {
+       if ( --cache_.active == 0 ) cache_.retired.clear();
+      }
+
+     snapshot( const snapshot& ) = delete;
+     snapshot& operator =( const snapshot& ) = delete;
+
+     const T& operator *() const { return *value_; }
+     const T* operator ->() const { return value_; }
+
+    private:
+     thread_cache& cache_;
+     const T* value_;
+   };
+
+  // config_cell::thread_cache
+  /**
+   * @brief Struct used to store the snapshots cached by a thread, for the last objects it used.
+   * 
+   * @tparam T The type of the configuration.
+   */
+  template <class T>
+  struct config_cell <T>::thread_cache
+   {
+    struct entry
+     {
+      const config_cell* cell = nullptr;
+      std::uint64_t version = 0;
+      std::shared_ptr <const T> value;
+     };
+
+    static thread_cache& local()
+     {
+      thread_local thread_cache cache;
+      return cache;
+     }
+
+    const T& get( const config_cell& cell )
+     {
+      const std::uint64_t version = cell.version_.load( std::memory_order_acquire );
+      entry* slot = nullptr;
+      for ( auto& e: entries )
+       {
+        if ( e.cell == &cell ) 
+         {
+          if ( e.version == version ) return *e.value;
+          slot = &e;
+          break;
+         }
+       }
+      if ( ! slot ) slot = &entries[ next++ % cache_size ];
+
+      // Loading the new snapshot, the replaced one may be used by an outer call
+      if ( active > 1 && slot -> value ) retired.push_back( std::move( slot -> value ) );
+      slot -> cell = &cell;
+      slot -> version = version;
+      slot -> value = cell.load();
+      return *slot -> value;
+     }
+
+    static constexpr std::size_t cache_size = 4;
+    entry entries[ cache_size ];
+    std::size_t next = 0;
+    unsigned active = 0;
+    std::vector <std::shared_ptr <const T>> retired;
+   };
+
+  //====================================================
+  //     Forward declarations
+  //====================================================
+  template <class Sep, class End, bool Flush> class StaticPrint;
+  template <class CharT> class BasicPrint;
+  template <std::size_t Capacity, class Sep, class End, bool Flush> class FixedPrint;
+
+  //====================================================
+  //     ptc_print class
+  //====================================================
+  /**
+   * @brief Class used to construct the print function.
+   * 
+   */
+  struct Print
+   {
+     //====================================================
+     //     Public constructors and destructor
+     //====================================================
+
+     // Default constructor
+     /**
+      * @brief Default constructor of the Print class. It initializes the basic class members and enable (if required) performance improvements..
+      * 
+      */
+     Print()
+      {
+       #ifdef PTC_ENABLE_PERFORMANCE_IMPROVEMENTS
+        performance_options();
+       #endif
+      }
+
+     //====================================================
+     //     Public setters
+     //====================================================
+
+     // setEnd
+     /**
+      * @brief Setter used to set the value of the "end" variable. Templated type is required in order to allow also char variables.
+      * 
+      * @tparam T The type of the expression inserted to set the value of "end" variable.
+      * @param end_val The inserted expression used to set the value of "end" variable.
+      */
+     template <class T> 
+     inline void setEnd( const T& end_val )
+      {
+       settings_.update( [ &end_val ]( settings& config )
+        {
+         config.end = end_val;
+         config.end_reset = config.end;
+         config.end_reset.append( reset_ANSI );
+        } );
+      }
+
+     // setSep
+     /**
+      * @brief Setter used to set the value of the "sep" variable. Templated type is required in order to allow also char variables.
+      * 
+      * @tparam T The type of the expression inserted to set the value of "sep" variable.
+      * @param end_val The inserted expression used to set the value of "sep" variable.
+      */
+     template <class T>
+     inline void setSep( const T& sep_val )
+      {
+       settings_.update( [ &sep_val ]( settings& config ){ config.sep = sep_val; } );
+      }
+
+     // setFlush
+     /**
+      * @brief Setter used to set the value of the "flush" variable. Templated type is required in order to allow also char variables.
+      * 
+      * 
+      * @param flush_val The inserted expression used to set the value of the "flush" variable.
+      */
+     inline void setFlush( const bool& flush_val )
+      {
+       settings_.update( [ flush_val ]( settings& config ){ config.flush = flush_val; } );
+       if ( flush_val ) line_buffer::commit_all( true );
+      }
+
+     // setFastFormatting
+     /**
+      * @brief Setter used to enable or disable the fast formatting of arithmetic types (enabled by default). With fast formatting, numbers are converted with std::to_chars directly into the output buffer (floating-point types use their shortest round-trip representation, like in Python). Fast formatting is automatically skipped for target streams with a non-default formatting state, in order to honour manipulators like std::hex or std::setprecision; disable it if you rely on the std::ostream representation of floating-point numbers with the default precision.
+      * 
+      * @param fast_val The value of the fast formatting flag.
+      */
+     inline void setFastFormatting( const bool& fast_val )
+      {
+       settings_.update( [ fast_val ]( settings& config ){ config.fast_format = fast_val; } );
+      }
+
+     // setEscapeScan
+     /**
+      * @brief Setter used to enable or disable the full scan of printed strings for ANSI escape sequences (disabled by default). By default only ptc::style objects and strings starting with an escape sequence reset the stream at the end of the call; enable the scan if escape sequences can also appear in the middle of your strings.
+      * 
+      * @param scan_val The value of the escape scan flag.
+      */
+     inline void setEscapeScan( const bool& scan_val )
+      {
+       settings_.update( [ scan_val ]( settings& config ){ config.escape_scan = scan_val; } );
+      }
+
+     // setMaxItems
+     /**
+      * @brief Setter used to set the maximum number of elements printed for each container. Further elements are replaced by a "..." marker (ex: "[1, 2, 3, ...]").
+      * 
+      * @param items_val The maximum number of elements, 0 for no limit (default).
+      */
+     inline void setMaxItems( const std::size_t& items_val )
+      {
+       settings_.update( [ items_val ]( settings& config ){ config.max_items = items_val; } );
+      }
+
+     // setMaxDepth
+     /**
+      * @brief Setter used to set the maximum number of nested container levels printed. Deeper containers are replaced by a "[...]" marker.
+      * 
+      * @param depth_val The maximum number of levels, 0 for no limit (default).
+      */
+     inline void setMaxDepth( const std::size_t& depth_val )
+      {
+       settings_.update( [ depth_val ]( settings& config ){ config.max_depth = depth_val; } );
+      }
+
+     // setParallel
+     /**
+      * @brief Setter used to format large containers (with at least 65536 elements and random-access iterators, ex: std::vector or std::deque) with several threads. The output is identical to the sequential one, but the elements must be safe to be formatted concurrently. Parallel formatting is used only with fast formatting and only if the "ptc/parallel_print.hpp" header is included, which keeps threads out of the default header.
+      * 
+      * @param threads_val The number of threads (ex: std::thread::hardware_concurrency()), 0 or 1 to disable parallel formatting (default).
+      */
+     inline void setParallel( unsigned threads_val )
+      {
+       settings_.update( [ threads_val ]( settings& config ){ config.parallel_threads = threads_val; } );
+      }
+
+     // setBuffer
+     /**
+      * @brief Setter used to enable the buffered output mode for std::cout. Each thread accumulates whole lines into its own buffer, which is committed to std::cout with a single write when its size reaches the threshold, when the deadline since its first pending line expires (checked at each print call, or by a background flusher thread if the "ptc/buffered_print.hpp" header is included, also if the thread does not print anymore), when the commit() method is called or when the thread exits. Setting the "flush" variable to true or a size of 0, which disables the buffered mode, commit the buffers of all the threads.
+      * 
+      * @param size_val The size threshold (in bytes) of the per-thread buffer.
+      * @param deadline_val The maximum time a line can be kept in the buffer.
+      */
+     inline void setBuffer( std::size_t size_val, std::chrono::milliseconds deadline_val = std::chrono::milliseconds( 100 ) )
+      {
+       settings_.update( [ size_val, deadline_val ]( settings& config )
+        {
+         config.buffer_size = size_val;
+         config.buffer_deadline = deadline_val;
+        } );
+       if ( ! size_val ) line_buffer::commit_all( false );
+      }
+
+     //====================================================
+     //     Public getters
+     //====================================================
+
+     // getEnd
+     /**
+      * @brief Getter used to get the value of the "end" variable. Mainly used for debugging.
+      * 
+      * @return std::string The value of the "end" variable.
+      */
+     inline std::string getEnd() const 
+      {
+       return snapshot( settings_ ) -> end;
+      }
+
+     // getSep
+     /**
+      * @brief Getter used to get the value of the "sep" variable. Mainly used for debugging.
+      * 
+      * @return std::string The value of the "sep" variable.
+      */
+     inline std::string getSep() const
+      {
+       return snapshot( settings_ ) -> sep;
+      }
+
+     // getFlush
+     /**
+      * @brief Getter used to get the value of the "flush" variable. Mainly used for debugging.
+      * 
+      * @return bool The value of the "flush" variable.
+      */
+     inline bool getFlush() const
+      {
+       return snapshot( settings_ ) -> flush;
+      }
+
+     // getFastFormatting
+     /**
+      * @brief Getter used to get the value of the fast formatting flag. Mainly used for debugging.
+      * 
+      * @return bool The value of the fast formatting flag.
+      */
+     inline bool getFastFormatting() const
+      {
+       return snapshot( settings_ ) -> fast_format;
+      }
+
+     // getEscapeScan
+     /**
+      * @brief Getter used to get the value of the escape scan flag. Mainly used for debugging.
+      * 
+      * @return bool The value of the escape scan flag.
+      */
+     inline bool getEscapeScan() const
+      {
+       return snapshot( settings_ ) -> escape_scan;
+      }
+
+     // getMaxItems
+     /**
+      * @brief Getter used to get the maximum number of elements printed for each container. Mainly used for debugging.
+      * 
+      * @return std::size_t The maximum number of elements, 0 if there is no limit.
+      */
+     inline std::size_t getMaxItems() const
+      {
+       return snapshot( settings_ ) -> max_items;
+      }
+
+     // getMaxDepth
+     /**
+      * @brief Getter used to get the maximum number of nested container levels printed. Mainly used for debugging.
+      * 
+      * @return std::size_t The maximum number of levels, 0 if there is no limit.
+      */
+     inline std::size_t getMaxDepth() const
+      {
+       return snapshot( settings_ ) -> max_depth;
+      }
+
+     // getParallel
+     /**
+      * @brief Getter used to get the number of threads used to format large containers. Mainly used for debugging.
+      * 
+      * @return unsigned The number of threads, 0 or 1 if parallel formatting is disabled.
+      */
+     inline unsigned getParallel() const
+      {
+       return snapshot( settings_ ) -> parallel_threads;
+      }
+
+     // getBuffer
+     /**
+      * @brief Getter used to get the size threshold of the buffered output mode. Mainly used for debugging.
+      * 
+      * @return std::size_t The size threshold of the per-thread buffer, 0 if the buffered mode is disabled.
+      */
+     inline std::size_t getBuffer() const
+      {
+       return snapshot( settings_ ) -> buffer_size;
+      }
+
+     //====================================================
+     //     Public methods
+     //====================================================
+
+     // commit
+     /**
+      * @brief Method used to write to std::cout all the lines buffered by the current thread in the buffered output mode. Buffers of other threads are not committed.
+      * 
+      */
+     inline void commit() const
+      {
+       line_buffer::local().commit( snapshot( settings_ ) -> flush );
+      }
+
+     //====================================================
+     //     Public operator () overloads
+     //====================================================
+
+     // General case
+     /**
+      * @brief Frontend implementation of the () operator overload to print to the output stream. The backend implementation is called in the required variation.
+      * 
+      * @tparam T Generic type of first object to be passed as argument to the backend implementation.
+      * @tparam Args Generic type of all the other objects to be passed to the backend implementation.
+      * @param first First object to be passed to the backend implementation.
+      * @param args The list of all the other objects to be passed to the backend implementation.
+      */
+     template <class T, class... Args>
+     void operator()( T&& first, Args&&... args ) const
+      {
+       if constexpr ( std::is_base_of_v <std::ostream, std::remove_reference_t<T>> )
+        {
+         print_backend( std::forward<T>( first ), std::forward<Args>( args )... );
+        }
+       else if constexpr ( is_sink_v <T> )
+        {
+         sink_backend( first, std::forward<Args>( args )... );
+        }
+       else
+        {
+         print_backend( std::cout, std::forward<T>( first ), std::forward<Args>( args )... );
+        }
+      }
+
+     // String initialization case
+     /**
+      * @brief Frontend implementation of the () operator overload to initialize its content with an std::string object. The backend implementation is called in the required variation. This overload is required in order to hide the output of the "print_backend" function during the initialization.
+      * 
+      * @tparam Args Generic type of all the other objects to be passed to the backend implementation.
+      * @param first First object to be passed to the backend implementation.
+      * @param args The list of all the other objects to be passed to the backend implementation.
+      * @return const std::string The whole print content in std::string format.
+      */
+     template <class... Args>
+     const std::string operator()( mode&& first, Args&&... args ) const
+      { 
+       if constexpr( sizeof...( args ) > 0 )
+        {
+         switch( first )
+          {
+           case mode::str:
+            {
+             if constexpr( erased_backend )
+              {
+               std::string str;
+               const auto erased = erase_all( args... );
+               view_erased( erased.data(), erased.size(), &str, []( void* target, std::string_view out ){ static_cast <std::string*> ( target ) -> assign( out.data(), out.size() ); } );
+               return str;
+              }
+             else
+              {
+               const snapshot config( settings_ );
+               format_buffer::lease buf;
+               buf -> setFast( config -> fast_format );
+               print_args( *config, *buf, std::forward<Args>( args )... );
+               return buf -> data();
+              }
+            }
+          }
+        }
+       return "";
+      }
+
+     // String target case
+     /**
+      * @brief Frontend implementation of the () operator overload to print into a caller-provided std::string. The string is used as the format buffer, therefore no allocation is performed if its capacity is large enough.
+      * 
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param first The target string.
+      * @param args The list of all the objects to be printed.
+      * @return std::size_t The size of the printed content.
+      */
+     template <class... Args>
+     std::size_t operator()( string_target&& first, Args&&... args ) const
+      {
+       first.str.clear();
+       if constexpr( sizeof...( args ) > 0 && erased_backend )
+        {
+         const auto erased = erase_all( args... );
+         string_erased( first.str, erased.data(), erased.size() );
+        }
+       else if constexpr( sizeof...( args ) > 0 )
+        {
+         const snapshot config( settings_ );
+         format_buffer::lease buf;
+         buf -> setFast( config -> fast_format );
+         buf -> data().swap( first.str );
+         print_args( *config, *buf, std::forward<Args>( args )... );
+         buf -> data().swap( first.str );
+        }
+       return first.str.size();
+      }
+
+     // Iterator target case
+     /**
+      * @brief Frontend implementation of the () operator overload to print into an output iterator.
+      * 
+      * @tparam OutputIt The type of the output iterator.
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param first The target iterator.
+      * @param args The list of all the objects to be printed.
+      * @return OutputIt The iterator past the last written character.
+      */
+     template <class OutputIt, class... Args>
+     OutputIt operator()( iterator_target <OutputIt>&& first, Args&&... args ) const
+      {
+       if constexpr( sizeof...( args ) > 0 && erased_backend )
+        {
+         const auto erased = erase_all( args... );
+         view_erased( erased.data(), erased.size(), &first.out, []( void* target, std::string_view out )
+          {
+           auto& it = *static_cast <OutputIt*> ( target );
+           it = std::copy( out.begin(), out.end(), it );
+          } );
+        }
+       else if constexpr( sizeof...( args ) > 0 )
+        {
+         const snapshot config( settings_ );
+         format_buffer::lease buf;
+         buf -> setFast( config -> fast_format );
+         print_args( *config, *buf, std::forward<Args>( args )... );
+         return std::copy( buf -> data().begin(), buf -> data().end(), first.out );
+        }
+       return first.out;
+      }
+
+     // Bounded target case
+     /**
+      * @brief Frontend implementation of the () operator overload to print at most "n" characters into an output iterator. The output is truncated if it does not fit.
+      * 
+      * @tparam OutputIt The type of the output iterator.
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param first The target iterator and its limit.
+      * @param args The list of all the objects to be printed.
+      * @return to_n_result <OutputIt> The iterator past the last written character and the size of the whole output.
+      */
+     template <class OutputIt, class... Args>
+     to_n_result <OutputIt> operator()( bounded_target <OutputIt>&& first, Args&&... args ) const
+      {
+       if constexpr( sizeof...( args ) > 0 && erased_backend )
+        {
+         const auto erased = erase_all( args... );
+         std::pair <bounded_target <OutputIt>*, std::size_t> target{ &first, 0 };
+         view_erased( erased.data(), erased.size(), &target, []( void* target_ptr, std::string_view out )
+          {
+           auto& [ bounded, size ] = *static_cast <std::pair <bounded_target <OutputIt>*, std::size_t>*> ( target_ptr );
+           size = out.size();
+           bounded -> out = std::copy_n( out.begin(), std::min( size, bounded -> n ), bounded -> out );
+          } );
+         return { first.out, target.second };
+        }
+       else if constexpr( sizeof...( args ) > 0 )
+        {
+         const snapshot config( settings_ );
+         format_buffer::lease buf;
+         buf -> setFast( config -> fast_format );
+         print_args( *config, *buf, std::forward<Args>( args )... );
+         const std::size_t size = buf -> data().size();
+         return { std::copy_n( buf -> data().begin(), std::min( size, first.n ), first.out ), size };
+        }
+       return { first.out, 0 };
+      }
+
+     #ifdef PTC_MEMORY_RESOURCE
+
+     // Memory resource case
+     /**
+      * @brief Frontend implementation of the () operator overload to print into a new std::pmr::string (see ptc::str_in). The call is formatted into the buffer of the current thread, which is reused among calls, therefore the only allocation is the one of the result, with its exact size, from the given memory resource.
+      * 
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param first The memory resource target.
+      * @param args The list of all the objects to be printed.
+      * @return std::pmr::string The whole print content.
+      */
+     template <class... Args>
+     std::pmr::string operator()( resource_target&& first, Args&&... args ) const
+      {
+       std::pmr::string str( first.resource );
+       if constexpr( sizeof...( args ) > 0 && erased_backend )
+        {
+         const auto erased = erase_all( args... );
+         view_erased( erased.data(), erased.size(), &str, []( void* target, std::string_view out ){ static_cast <std::pmr::string*> ( target ) -> assign( out.data(), out.size() ); } );
+        }
+       else if constexpr( sizeof...( args ) > 0 )
+        {
+         const snapshot config( settings_ );
+         format_buffer::lease buf;
+         buf -> setFast( config -> fast_format );
+         print_args( *config, *buf, std::forward<Args>( args )... );
+         str.assign( buf -> data().data(), buf -> data().size() );
+        }
+       return str;
+      }
+
+     #endif
+
+     // No arguments case
+     /**
+      * @brief Template operator redefinition used to print an empty line on the screen. This is the no argument case overload. Can be used with "ptc::print()" or "ptc::print( ostream_name )".
+      * 
+      * @param os The stream in which you want to print the output.
+      */
+     void operator () ( std::ostream& os = std::cout ) const
+      {
+       const snapshot config( settings_ );
+       if ( &os == &std::cout && line_buffer::local().active( config -> buffer_size ) )
+        {
+         line_buffer::local().append( config -> end, *config, config -> flush );
+         return;
+        }
+       os << config -> end;
+       if ( config -> flush ) os << std::flush;
+      }
+
+    protected:
+
+     template <class Sep, class End, bool Flush> friend class StaticPrint;
+     template <class CharT> friend class BasicPrint;
+     template <std::size_t Capacity, class Sep, class End, bool Flush> friend class FixedPrint;
+
+     //====================================================
+     //     Protected structs
+     //====================================================
+
+     // settings
+     /**
+      * @brief Struct used to store an immutable snapshot of the configuration of a Print object. Setters publish a new snapshot, therefore each print call reads a consistent configuration without locking.
+      * 
+      */
+     struct settings
+      {
+       std::string end = "\n", sep = " ", end_reset = "\n\033[0m";
+       bool flush = false, fast_format = true, escape_scan = false;
+       std::size_t max_items = 0, max_depth = 0;
+       unsigned parallel_threads = 1;
+       std::size_t buffer_size = 0;
+       std::chrono::milliseconds buffer_deadline{ 0 };
+      };
+
+     // snapshot
+     /**
+      * @brief Type used to read the configuration of a Print object for the duration of a print call.
+      * 
+      */
+     using snapshot = config_cell <settings>::snapshot;
+
+     //====================================================
+     //     Protected attributes
+     //====================================================
+     config_cell <settings> settings_;
+
+     //====================================================
+     //     Protected methods
+     //====================================================
+
+     // print_args
+     /**
+      * @brief Method used to write all the arguments of a print call into a format buffer, using a configuration snapshot, unless it is overridden by call options.
+      * 
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param config The configuration snapshot of the call.
+      * @param buf The buffer in which the output is formatted.
+      * @param args The list of objects to be printed on the screen.
+      * @return bool True if the stream must be flushed after the call.
+      */
+     template <class... Args>
+     static bool print_args( const settings& config, format_buffer& buf, Args&&... args )
+      {
+       buf.setLimits( config.max_items, config.max_depth );
+       buf.setParallel( config.parallel_threads );
+       return format_call( buf, { config.sep, config.end, config.flush, config.escape_scan, config.end_reset }, std::forward<Args>( args )... );
+      }
+
+     // call_config
+     /**
+      * @brief Struct used to store the configuration of a single print call. "end_reset" is the end followed by the ANSI reset sequence, precomputed when the end is set, so that both are appended with a single copy; if it is empty they are appended separately.
+      * 
+      */
+     struct call_config
+      {
+       std::string_view sep, end;
+       bool flush, scan;
+       std::string_view end_reset;
+      };
+
+     // format_call
+     /**
+      * @brief Method used to apply the call options (ex: ptc::sep) of a print call and to write all the other arguments into a format buffer. Call options are filtered out at compile time, therefore calls without options are formatted directly. If the type-erased backend is used, the arguments are type-erased instead, and formatted by the non-template format_erased method.
+      * 
+      * @tparam Args Generic type of all the arguments.
+      * @param buf The buffer in which the output is formatted.
+      * @param config The default configuration of the call.
+      * @param args The list of arguments.
+      * @return bool True if the stream must be flushed after the call.
+      */
+     template <class... Args>
+     static bool format_call( format_buffer& buf, call_config config, Args&&... args )
+      {
+       if constexpr( erased_backend )
+        {
+         const auto erased = erase_all( args... );
+         return format_erased( buf, config, erased.data(), erased.size() );
+        }
+       else
+        {
+         if constexpr( ( is_option_v<Args> || ... ) )
+          {
+           ( apply_option( args, config ), ... );
+           format_objects( buf, config, typename object_indices <0, std::index_sequence<>, Args...>::type{}, std::forward_as_tuple( std::forward<Args>( args )... ) );
+          }
+         else if constexpr( sizeof...( args ) > 0 ) format_args( buf, config, std::forward<Args>( args )... );
+         else buf.append( config.end );
+         return config.flush;
+        }
+      }
+
+     // format_erased
+     /**
+      * @brief Method used to apply the call options of a print call and to write all the other arguments into a format buffer, from their type-erased form. It has the same behaviour of format_call, but it is not a template, therefore it is compiled once for all the call signatures.
+      * 
+      * @param buf The buffer in which the output is formatted.
+      * @param config The default configuration of the call.
+      * @param args The array of type-erased arguments.
+      * @param n The number of arguments.
+      * @return bool True if the stream must be flushed after the call.
+      */
+     static bool format_erased( format_buffer& buf, call_config config, const erased_arg* args, std::size_t n );
+
+     // format_args
+     /**
+      * @brief Method used to write all the arguments, separators, end and ANSI reset sequence of a print call into a format buffer. The stream is automatically reset if a ptc::style or a string starting with an ANSI escape sequence is sent to output (or containing it, if the escape scan is enabled). Arguments which cannot contain escape sequences are excluded at compile time.
+      * 
+      * @tparam T Generic type of first object to be printed.
+      * @tparam Args Generic type of all the other objects to be printed.
+      * @param buf The buffer in which the output is formatted.
+      * @param config The configuration of the call.
+      * @param first First printed object.
+      * @param args The list of objects to be printed on the screen.
+      */
+     template <class T, class... Args>
+     static void format_args( format_buffer& buf, const call_config& config, T&& first, Args&&... args )
+      {
+       // Printing all the arguments
+       buf.write( first );
+       if constexpr( sizeof...( args ) > 0 ) 
+        {
+         if ( is_null_str( first ) || is_escape( first, ANSI::first ) ) ( ( buf.write( args ), buf.append( config.sep ) ), ...); 
+         else ( ( buf.append( config.sep ), buf.write( args ) ), ...);
+        }
+
+       // Printing the end and resetting the stream from ANSI escape sequences
+       bool reset = false;
+       if constexpr( ( is_style_v<T> || ... || is_style_v<Args> ) ) reset = true;
+       else if constexpr( ( is_string_like_v<std::decay_t<T>> || ... || is_string_like_v<std::decay_t<Args>> ) )
+        {
+         reset = is_escape( first, ANSI::generic, config.scan ) || ( is_escape( args, ANSI::generic, config.scan ) || ... );
+        }
+       if ( ! reset ) buf.append( config.end );
+       else if ( ! config.end_reset.empty() ) buf.append( config.end_reset );
+       else
+        {
+         buf.append( config.end );
+         buf.append( reset_ANSI );
+        }
+      }
+
+     // stream_mutex
+     /**
+      * @brief Method used to get the mutex which guards a given output stream. Mutexes are stored in a striped table indexed by the address of the stream buffer, therefore writes to unrelated streams (ex: two different std::ostringstream objects) do not contend for the same lock, while writes to the same stream are still atomic per call.
+      * 
+      * @tparam T_os The type of the output stream object.
+      * @param os The stream whose mutex is requested.
+      * @return std::mutex& The mutex associated to the stream buffer of the stream.
+      */
+     template <class T_os>
+     static std::mutex& stream_mutex( const T_os& os )
+      {
+       auto key = reinterpret_cast <std::uintptr_t> ( os.rdbuf() );
+       key ^= key >> 17;
+       key *= static_cast <std::uintptr_t> ( 0x9E3779B97F4A7C15ull );
+       return stream_mutexes_[ ( key >> 7 ) % stream_stripes ].mutex;
+      }
+     
+    private:
+
+     //====================================================
+     //     Private structs
+     //====================================================
+
+     // stream_stripe
+     /**
+      * @brief Struct used to store a single mutex of the striped lock table. It is aligned to the cache line size in order to avoid false sharing among different stripes.
+      * 
+      */
+     struct alignas( 64 ) stream_stripe
+      {
+       std::mutex mutex;
+      };
+
+     // line_buffer
+     /**
+      * @brief Struct used to store the lines printed to std::cout by a thread in the buffered output mode. Each buffer is guarded by its own mutex, which is only contended when the buffer is committed by another thread (see buffer_registry). Pending lines are committed when the thread exits.
+      * 
+      */
+     struct line_buffer
+      {
+       // Constructor
+       line_buffer()
+        {
+         buffer_registry& registry = line_buffers();
+         std::lock_guard <std::mutex> lock{ registry.mutex };
+         registry.buffers.push_back( this );
+        }
+
+       // Destructor
+       ~line_buffer()
+        {
+          {
+           buffer_registry& registry = line_buffers();
+           std::lock_guard <std::mutex> lock{ registry.mutex };
+           registry.buffers.erase( std::find( registry.buffers.begin(), registry.buffers.end(), this ) );
+          }
+         commit( false );
+        }
+
+       line_buffer( const line_buffer& ) = delete;
+       line_buffer& operator =( const line_buffer& ) = delete;
+
+       // local
+       /**
+        * @brief Method used to get the buffer of the current thread.
+        * 
+        * @return line_buffer& The buffer of the current thread.
+        */
+       static line_buffer& local()
+        {
+         thread_local line_buffer buffer;
+         return buffer;
+        }
+
+       // active
+       /**
+        * @brief Method used to check if a line has to be buffered. Lines are also buffered when the buffered mode is disabled but older lines are still pending, in order to preserve their order.
+        * 
+        * @param size The size threshold of the buffered mode.
+        * @return true If the line has to be buffered.
+        * @return false Otherwise.
+        */
+       bool active( std::size_t size ) const
+        {
+         return size || has_pending.load( std::memory_order_relaxed );
+        }
+
+       // append
+       /**
+        * @brief Method used to append a formatted line to the buffer and to commit it if needed. If the flusher thread is installed (see buffer_flusher) it is woken when the first pending line is appended, so that it commits the buffer when its deadline expires, otherwise the deadline is checked here.
+        * 
+        * @param line The formatted line.
+        * @param config The Print object which contains the buffer configuration.
+        * @param flush_val If true, the buffer is committed and the stream is flushed.
+        */
+       void append( std::string_view line, const settings& config, bool flush_val )
+        {
+         std::unique_lock <std::mutex> lock{ mutex };
+         const bool first = pending.empty();
+         if ( first ) 
+          {
+           first_line = std::chrono::steady_clock::now();
+           deadline = config.buffer_deadline;
+           has_pending.store( true, std::memory_order_relaxed );
+          }
+         pending.append( line.data(), line.size() );
+         if ( flush_val || pending.size() >= config.buffer_size || deadline.count() <= 0 ) commit_locked( flush_val );
+         else if ( ! wake_flusher_ )
+          {
+           if ( ! first && std::chrono::steady_clock::now() - first_line >= deadline ) commit_locked( false );
+          }
+         else if ( first )
+          {
+           lock.unlock();
+           wake_flusher_();
+          }
+        }
+
+       // commit
+       /**
+        * @brief Method used to write all the pending lines to std::cout with a single write.
+        * 
+        * @param flush_val If true, std::cout is also flushed.
+        */
+       void commit( bool flush_val )
+        {
+         std::lock_guard <std::mutex> lock{ mutex };
+         commit_locked( flush_val );
+        }
+
+       // commit_locked
+       /**
+        * @brief Method used to commit the buffer when its mutex is already locked.
+        * 
+        * @param flush_val If true, std::cout is also flushed.
+        */
+       void commit_locked( bool flush_val )
+        {
+         if ( ! pending.empty() )
+          {
+           std::lock_guard <std::mutex> lock{ stream_mutex( std::cout ) };
+           std::cout.write( pending.data(), static_cast <std::streamsize> ( pending.size() ) );
+           if ( flush_val ) std::cout.flush();
+           pending.clear();
+           has_pending.store( false, std::memory_order_relaxed );
+          }
+        }
+
+       // commit_all
+       /**
+        * @brief Method used to commit the buffers of all the threads.
+        * 
+        * @param flush_val If true, std::cout is also flushed.
+        */
+       static void commit_all( bool flush_val )
+        {
+         buffer_registry& registry = line_buffers();
+         std::lock_guard <std::mutex> lock{ registry.mutex };
+         for ( line_buffer* buffer: registry.buffers ) buffer -> commit( false );
+         if ( flush_val )
+          {
+           std::lock_guard <std::mutex> stream_lock{ stream_mutex( std::cout ) };
+           std::cout.flush();
+          }
+        }
+
+       std::mutex mutex;
+       std::string pending;
+       std::atomic <bool> has_pending{ false };
+       std::chrono::steady_clock::time_point first_line;
+       std::chrono::milliseconds deadline{ 0 };
+      };
+
+     // buffer_registry
+     /**
+      * @brief Struct used to store the line buffers of all the threads, which are committed together by setFlush and setBuffer and, if it is installed, by the flusher thread.
+      * 
+      */
+     struct buffer_registry
+      {
+       std::mutex mutex;
+       std::vector <line_buffer*> buffers;
+      };
+
+     // line_buffers
+     /**
+      * @brief Method used to get the registry of the line buffers. It is never deallocated, since threads may exit after the static objects have been destroyed.
+      * 
+      * @return buffer_registry& The registry.
+      */
+     static buffer_registry& line_buffers()
+      {
+       static buffer_registry* const registry = new buffer_registry();
+       return *registry;
+      }
+
+     //====================================================
+     //     Private methods
+     //====================================================
+
+     // is_escape
+     /**
+      * @brief This method is used to check if an input variable is an ANSI escape sequency or not. A ptc::style is always an escape sequence, while strings are checked only at their first character (without computing their length), unless the full scan is requested.
+      * 
+      * @tparam T Template type of the input variable.
+      * @param str The input variable.
+      * @param flag A flag which let to return different things with respect to its value. If flag = ANSI::first the variable must be a single escape sequence, otherwise, if flag = ANSI::generic, the variable must start with an escape sequence (or contain it, if scan is true).
+      * @param scan If true, the whole string is scanned for escape sequences.
+      * @return true If the input variable is an ANSI escape sequency.
+      * @return false Otherwise.
+      */
+     template <typename T>
+     static bool is_escape( const T& str, ANSI&& flag, bool scan = false )
+      {
+       if constexpr( is_style_v <T> ) return true;
+       else if constexpr( std::is_pointer_v <T> || std::is_array_v <T> )
+        {
+         if constexpr( is_string_like_v <std::decay_t<T>> )
+          {
+           const char* data = str;
+           if ( ! data || data[ 0 ] != '\033' ) return flag == ANSI::generic && scan && data && contains_escape( data );
+           if ( flag == ANSI::generic ) return true;
+           for ( std::size_t i = 1; i < 7; ++i ) 
+            {
+             if ( data[ i ] == '\0' ) return true;
+            }
+          }
+         return false;
+        }
+       else if constexpr( is_string_like_v <T> )
+        {
+         const std::string_view data( str );
+         if ( data.empty() || data[ 0 ] != '\033' ) return flag == ANSI::generic && scan && contains_escape( data );
+         return flag == ANSI::generic || data.size() < 7;
+        }
+       return false;
+      }
+
+     // is_null_str
+     /**
+      * @brief This method is used to check if an input variable is a null string or not.
+      * 
+      * @tparam T The templated type of the input variable.
+      * @param str The input variable.
+      * @return true If the variable is a null string.
+      * @return false Otherwise.
+      */
+     template <typename T>
+     static constexpr bool is_null_str( const T& str )
+      {
+       if constexpr( ( std::is_pointer_v <T> || std::is_array_v <T> ) && is_string_like_v <std::decay_t<T>> )
+        {
+         const char* data = str;
+         return ! data || data[ 0 ] == '\0';
+        }
+       else if constexpr( is_string_like_v <T> ) return std::string_view( str ).empty();
+       return false;
+      }
+
+     // contains_escape
+     /**
+      * @brief This method is used to scan a whole string for the ANSI escape character. 16 characters per step are compared with SSE2 instructions, when available.
+      * 
+      * @param str The string to be scanned.
+      * @return true If the string contains the escape character.
+      * @return false Otherwise.
+      */
+     static bool contains_escape( std::string_view str )
+      {
+       const char* first = str.data();
+       const char* const last = first + str.size();
+       #ifdef PTC_SSE2
+        const __m128i escape = _mm_set1_epi8( '\033' );
+        for ( ; last - first >= 16; first += 16 )
+         {
+          const __m128i chunk = _mm_loadu_si128( reinterpret_cast <const __m128i*> ( first ) );
+          if ( _mm_movemask_epi8( _mm_cmpeq_epi8( chunk, escape ) ) ) return true;
+         }
+       #endif
+       return std::find( first, last, '\033' ) != last;
+      }
+
+     // apply_option
+     /**
+      * @brief Method used to apply a call option. Other arguments are ignored.
+      * 
+      * @tparam T The type of the argument.
+      * @param arg The argument.
+      * @param config The configuration of the call.
+      */
+     template <class T>
+     static void apply_option( const T& arg, call_config& config )
+      {
+       if constexpr( std::is_same_v <T, sep_option> ) config.sep = arg.value;
+       else if constexpr( std::is_same_v <T, end_option> ) 
+        {
+         config.end = arg.value;
+         config.end_reset = {};
+        }
+       else if constexpr( std::is_same_v <T, flush_option> ) config.flush = true;
+      }
+
+     // format_objects
+     /**
+      * @brief Method used to write the arguments of a print call which are not call options.
+      * 
+      * @tparam Is The indices of the arguments which are not call options.
+      * @tparam Tuple The type of the tuple of arguments.
+      * @param buf The buffer in which the output is formatted.
+      * @param config The configuration of the call.
+      * @param args The tuple of arguments.
+      */
+     template <std::size_t... Is, class Tuple>
+     static void format_objects( format_buffer& buf, const call_config& config, std::index_sequence<Is...>, Tuple&& args )
+      {
+       if constexpr( sizeof...( Is ) > 0 ) format_args( buf, config, std::get<Is>( std::move( args ) )... );
+       else buf.append( config.end );
+      }
+
+     // erase
+     /**
+      * @brief Method used to get the type-erased form of a print argument.
+      * 
+      * @tparam T The type of the argument.
+      * @param x The argument.
+      * @return erased_arg The type-erased argument, which refers to "x" if it is an object.
+      */
+     template <class T>
+     static erased_arg erase( const T& x )
+      {
+       erased_arg arg{};
+       if constexpr( std::is_same_v <T, sep_option> || std::is_same_v <T, end_option> )
+        {
+         arg.type = std::is_same_v <T, sep_option> ? arg_type::sep : arg_type::end;
+         arg.value.str = x.value.data();
+         arg.extra.size = x.value.size();
+        }
+       else if constexpr( std::is_same_v <T, flush_option> ) arg.type = arg_type::flush;
+       else if constexpr( is_string_like_v <T> && std::is_pointer_v <T> )
+        {
+         arg.type = arg_type::c_string;
+         arg.value.str = x;
+        }
+       else if constexpr( is_string_like_v <T> || is_style_v <T> )
+        {
+         const std::string_view str = [ &x ]
+          { 
+           if constexpr( is_style_v <T> ) return x.code;
+           else if constexpr( std::is_array_v <T> ) return std::string_view( x, std::char_traits <char>::length( x ) );
+           else return std::string_view( x ); 
+          }();
+         if constexpr( is_style_v <T> ) arg.type = arg_type::style;
+         else arg.type = std::is_array_v <T> && ! str.empty() && str[ 0 ] != '\033' ? arg_type::plain_string : arg_type::string;
+         arg.value.str = str.data();
+         arg.extra.size = str.size();
+        }
+       else if constexpr( is_character_v <T> )
+        {
+         arg.type = arg_type::character;
+         arg.value.character = static_cast <char> ( x );
+        }
+       else if constexpr( std::is_same_v <T, bool> )
+        {
+         arg.type = arg_type::boolean;
+         arg.value.boolean = x;
+        }
+       else if constexpr( std::is_integral_v <T> && ! is_wide_character_v <T> && std::is_signed_v <T> )
+        {
+         arg.type = arg_type::signed_integer;
+         arg.value.signed_integer = x;
+         arg.extra.size = sizeof( T );
+        }
+       else if constexpr( std::is_integral_v <T> && ! is_wide_character_v <T> )
+        {
+         arg.type = arg_type::unsigned_integer;
+         arg.value.unsigned_integer = x;
+         arg.extra.size = sizeof( T );
+        }
+       else if constexpr( std::is_same_v <T, long double> && float_to_chars )
+        {
+         arg.type = arg_type::long_float;
+         arg.value.ptr = &x;
+        }
+       else if constexpr( std::is_floating_point_v <T> && float_to_chars )
+        {
+         arg.type = std::is_same_v <T, float> ? arg_type::single_float : arg_type::double_float;
+         arg.value.floating = x;
+        }
+       else
+        {
+         arg.type = arg_type::object;
+         arg.value.ptr = std::addressof( x );
+         arg.extra.write = &write_object <T>;
+        }
+       return arg;
+      }
+
+     // write_object
+     /**
+      * @brief Method used to write a type-erased object into a format buffer. It is instantiated once per object type, instead of once per call signature.
+      * 
+      * @tparam T The type of the object.
+      * @param buf The buffer in which the object is written.
+      * @param ptr The address of the object.
+      */
+     template <class T>
+     static void write_object( format_buffer& buf, const void* ptr );
+
+     // write_arg
+     /**
+      * @brief Method used to write a type-erased argument into a format buffer. Strings, characters and booleans are appended directly and numbers are converted with their widest type, unless the fast formatting is disabled.
+      * 
+      * @param buf The buffer in which the argument is written.
+      * @param arg The type-erased argument.
+      */
+     static void write_arg( format_buffer& buf, const erased_arg& arg );
+
+     // insert_arg
+     /**
+      * @brief Method used to write a type-erased argument into a format buffer when the fast formatting is disabled, i.e. through the buffer stream. Integers are written with their original size, so that the formatting flags of the stream (ex: std::hex) are applied as for the original type.
+      * 
+      * @param buf The buffer in which the argument is written.
+      * @param arg The type-erased argument.
+      */
+     static void insert_arg( format_buffer& buf, const erased_arg& arg );
+
+     // is_escape_arg
+     /**
+      * @brief Method used to check if a type-erased argument is an ANSI escape sequence (see is_escape).
+      * 
+      * @param arg The type-erased argument.
+      * @param flag The kind of check (see is_escape).
+      * @param scan If true, the whole string is scanned for escape sequences.
+      * @return true If the argument is an ANSI escape sequence.
+      * @return false Otherwise.
+      */
+     static bool is_escape_arg( const erased_arg& arg, ANSI flag, bool scan );
+
+     // is_null_arg
+     /**
+      * @brief Method used to check if a type-erased argument is a null string (see is_null_str).
+      * 
+      * @param arg The type-erased argument.
+      * @return true If the argument is a null string.
+      * @return false Otherwise.
+      */
+     static bool is_null_arg( const erased_arg& arg );
+
+     // erase_all
+     /**
+      * @brief Method used to get the type-erased form of all the arguments of a print call.
+      * 
+      * @tparam Args Generic type of all the arguments.
+      * @param args The list of arguments.
+      * @return std::array <erased_arg, sizeof...( Args )> The array of type-erased arguments.
+      */
+     template <class... Args>
+     static std::array <erased_arg, sizeof...( Args )> erase_all( const Args&... args )
+      {
+       return { { erase( args )... } };
+      }
+
+     // print_erased
+     /**
+      * @brief Method used to write all the type-erased arguments of a print call into a format buffer, using a configuration snapshot (see print_args).
+      * 
+      * @param config The configuration snapshot of the call.
+      * @param buf The buffer in which the output is formatted.
+      * @param args The array of type-erased arguments.
+      * @param n The number of arguments.
+      * @return bool True if the stream must be flushed after the call.
+      */
+     static bool print_erased( const settings& config, format_buffer& buf, const erased_arg* args, std::size_t n );
+
+     // stream_erased
+     /**
+      * @brief Non-template backend of the print calls to an output stream (see print_backend).
+      * 
+      * @param os The stream in which you want to print the output.
+      * @param args The array of type-erased arguments.
+      * @param n The number of arguments.
+      */
+     void stream_erased( std::ostream& os, const erased_arg* args, std::size_t n ) const;
+
+     // sink_erased
+     /**
+      * @brief Non-template backend of the print calls to an output sink (see sink_backend).
+      * 
+      * @param sink The address of the output sink.
+      * @param write The function which writes into the sink.
+      * @param args The array of type-erased arguments.
+      * @param n The number of arguments.
+      */
+     void sink_erased( void* sink, void ( *write )( void*, std::string_view, bool ), const erased_arg* args, std::size_t n ) const;
+
+     // view_erased
+     /**
+      * @brief Non-template backend of the print calls which produce a string or write into an output iterator. The call is formatted into the buffer of the current thread, which is then passed to the "consume" function.
+      * 
+      * @param args The array of type-erased arguments.
+      * @param n The number of arguments.
+      * @param target The address of the output target.
+      * @param consume The function which consumes the formatted output.
+      */
+     void view_erased( const erased_arg* args, std::size_t n, void* target, void ( *consume )( void*, std::string_view ) ) const;
+
+     // string_erased
+     /**
+      * @brief Non-template backend of the print calls into a caller-provided std::string, which is used as the format buffer.
+      * 
+      * @param str The target string.
+      * @param args The array of type-erased arguments.
+      * @param n The number of arguments.
+      */
+     void string_erased( std::string& str, const erased_arg* args, std::size_t n ) const;
+
+     // print_backend
+     /**
+      * @brief Backend implementation of the () operator overloads to print to the output stream. The whole call is first formatted into the buffer of the current thread without holding any lock, then only the final contiguous write to the stream is serialized. Calls containing large containers are committed in chunks, each of them written atomically.
+      * 
+      * @tparam T_os The type of the output stream object.
+      * @tparam T Generic type of first object to be printed.
+      * @tparam Args Generic type of all the other objects to be printed.
+      * @param os The stream in which you want to print the output.
+      * @param first First printed object.
+      * @param args The list of objects to be printed on the screen.
+      */
+     template <class T_os, class T, class... Args>
+     void print_backend( T_os&& os, T&& first, Args&&... args ) const
+      {
+       if constexpr( erased_backend )
+        {
+         const auto erased = erase_all( first, args... );
+         stream_erased( os, erased.data(), erased.size() );
+        }
+       else
+        {
+         // Formatting without holding the lock
+         const snapshot config( settings_ );
+         const bool buffered = &os == &std::cout && line_buffer::local().active( config -> buffer_size );
+         auto write_chunk = [ &config, &os, buffered ]( std::string_view chunk )
+          {
+           if ( buffered ) line_buffer::local().append( chunk, *config, false );
+           else
+            {
+             std::lock_guard <std::mutex> lock{ stream_mutex( os ) };
+             os.write( chunk.data(), static_cast <std::streamsize> ( chunk.size() ) );
+            }
+          };
+         format_buffer::lease buf;
+         buf -> copy_format( os, config -> fast_format );
+         buf -> setChunkWriter( write_chunk );
+         const bool flush_val = print_args( *config, *buf, std::forward<T>( first ), std::forward<Args>( args )... );
+
+         // Buffering the formatted output
+         if ( buffered )
+          {
+           line_buffer::local().append( buf -> data(), *config, flush_val );
+           return;
+          }
+
+         // Committing the formatted output
+         std::lock_guard <std::mutex> lock{ stream_mutex( os ) };
+         os.write( buf -> data().data(), static_cast <std::streamsize> ( buf -> data().size() ) );
+         if ( flush_val && ! std::is_base_of_v <std::ostringstream, T_os> ) os << std::flush;
+        }
+      }
+
+     // sink_backend
+     /**
+      * @brief Backend implementation of the () operator overloads to print to an output sink. The whole call is formatted into the buffer of the current thread and passed to the sink, which is responsible for its own synchronization. Calls containing large containers are passed in chunks.
+      * 
+      * @tparam T_sink The type of the output sink.
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param sink The output sink.
+      * @param args The list of objects to be printed.
+      */
+     template <class T_sink, class... Args>
+     void sink_backend( T_sink& sink, Args&&... args ) const
+      {
+       if constexpr( erased_backend )
+        {
+         const auto erased = erase_all( args... );
+         sink_erased( &sink, []( void* target, std::string_view out, bool flush_val ){ static_cast <T_sink*> ( target ) -> write( out, flush_val ); }, erased.data(), erased.size() );
+        }
+       else
+        {
+         const snapshot config( settings_ );
+         auto write_chunk = [ &sink ]( std::string_view chunk ){ sink.write( chunk, false ); };
+         format_buffer::lease buf;
+         buf -> setFast( config -> fast_format );
+         buf -> setChunkWriter( write_chunk );
+         const bool flush_val = print_args( *config, *buf, std::forward<Args>( args )... );
+         sink.write( buf -> data(), flush_val );
         }
-       if ( getFlush() && ! std::is_base_of_v <std::ostringstream, T_os> ) os << std::flush;
       }
 
      // performance_options
@@ -459,15 +2774,17 @@ namespace ptc
      //====================================================
      //     Private attributes
      //====================================================
-     std::string end, sep;
      static std::mutex mutex_;
-     bool flush;
+     static stream_stripe stream_mutexes_[];
+     static inline void ( *wake_flusher_ )() = nullptr;
+
+     friend struct buffer_flusher;
 
      //====================================================
      //     Private constants
      //====================================================
-     inline static const std::string reset_ANSI = "\033[0m";
-     template <class T> inline static const std::string null_str = Print::null_string<const T&>::value;
+     static constexpr std::string_view reset_ANSI = "\033[0m";
+     static constexpr std::size_t stream_stripes = 64;
    }; // end of Print class
    
   //====================================================
@@ -477,8 +2794,235 @@ namespace ptc
   // Print::mutex_ definiton
   inline std::mutex Print::mutex_;
 
+  // Print::stream_mutexes_ definition
+  inline Print::stream_stripe Print::stream_mutexes_[ Print::stream_stripes ];
+
   // print function initialization
   inline Print print;
+
+  //====================================================
+  //     Type-erased backend
+  //====================================================
+
+  // Print::write_object definition
+  template <class T>
+  void Print::write_object( format_buffer& buf, const void* ptr )
+   {
+    buf.write( *static_cast <const T*> ( ptr ) );
+   }
+
+  // Common objects, instantiated in src/print.cpp in case of separate compilation
+  #if defined( PTC_SEPARATE_COMPILATION ) && ! defined( PTC_SOURCE )
+   extern template void Print::write_object <std::nullptr_t>( format_buffer&, const void* );
+   extern template void Print::write_object <std::complex <double>>( format_buffer&, const void* );
+   extern template void Print::write_object <std::vector <int>>( format_buffer&, const void* );
+   extern template void Print::write_object <std::vector <double>>( format_buffer&, const void* );
+   extern template void Print::write_object <std::vector <std::string>>( format_buffer&, const void* );
+  #endif
+
+  // Non-template methods, compiled only in src/print.cpp in case of separate compilation
+  #if ! defined( PTC_SEPARATE_COMPILATION ) || defined( PTC_SOURCE )
+
+  // Print::format_erased definition
+  PTC_NOINLINE PTC_INLINE bool Print::format_erased( format_buffer& buf, call_config config, const erased_arg* args, std::size_t n )
+   {
+    // Applying the call options
+    const erased_arg* const last = args + n;
+    const erased_arg* first = nullptr;
+    for ( const erased_arg* arg = args; arg != last; ++arg )
+     {
+      if ( arg -> type == arg_type::sep ) config.sep = std::string_view( arg -> value.str, arg -> extra.size );
+      else if ( arg -> type == arg_type::end )
+       {
+        config.end = std::string_view( arg -> value.str, arg -> extra.size );
+        config.end_reset = {};
+       }
+      else if ( arg -> type == arg_type::flush ) config.flush = true;
+      else if ( ! first ) first = arg;
+     }
+    if ( ! first )
+     {
+      buf.append( config.end );
+      return config.flush;
+     }
+
+    // Printing all the arguments
+    const bool sep_after = is_null_arg( *first ) || is_escape_arg( *first, ANSI::first, false );
+    bool reset = false;
+    for ( const erased_arg* arg = first; arg != last; ++arg )
+     {
+      if ( arg -> type >= arg_type::sep ) continue;
+      if ( arg != first && ! sep_after ) buf.append( config.sep );
+      write_arg( buf, *arg );
+      if ( arg != first && sep_after ) buf.append( config.sep );
+      if ( ! reset && ( arg -> type <= arg_type::style || ( config.scan && arg -> type == arg_type::plain_string ) ) ) reset = is_escape_arg( *arg, ANSI::generic, config.scan );
+     }
+
+    // Printing the end and resetting the stream from ANSI escape sequences
+    if ( ! reset ) buf.append( config.end );
+    else if ( ! config.end_reset.empty() ) buf.append( config.end_reset );
+    else
+     {
+      buf.append( config.end );
+      buf.append( reset_ANSI );
+     }
+    return config.flush;
+   }
+
+  // Print::print_erased definition
+  PTC_INLINE bool Print::print_erased( const settings& config, format_buffer& buf, const erased_arg* args, std::size_t n )
+   {
+    buf.setLimits( config.max_items, config.max_depth );
+    buf.setParallel( config.parallel_threads );
+    return format_erased( buf, { config.sep, config.end, config.flush, config.escape_scan, config.end_reset }, args, n );
+   }
+
+  // Print::stream_erased definition
+  PTC_NOINLINE PTC_INLINE void Print::stream_erased( std::ostream& os, const erased_arg* args, std::size_t n ) const
+   {
+    // Formatting without holding the lock
+    const snapshot config( settings_ );
+    const bool buffered = &os == &std::cout && line_buffer::local().active( config -> buffer_size );
+    auto write_chunk = [ &config, &os, buffered ]( std::string_view chunk )
+     {
+      if ( buffered ) line_buffer::local().append( chunk, *config, false );
+      else
+       {
+        std::lock_guard <std::mutex> lock{ stream_mutex( os ) };
+        os.write( chunk.data(), static_cast <std::streamsize> ( chunk.size() ) );
+       }
+     };
+    format_buffer::lease buf;
+    buf -> copy_format( os, config -> fast_format );
+    buf -> setChunkWriter( write_chunk );
+    const bool flush_val = print_erased( *config, *buf, args, n );
+
+    // Buffering the formatted output
+    if ( buffered )
+     {
+      line_buffer::local().append( buf -> data(), *config, flush_val );
+      return;
+     }
+
+    // Committing the formatted output
+    std::lock_guard <std::mutex> lock{ stream_mutex( os ) };
+    os.write( buf -> data().data(), static_cast <std::streamsize> ( buf -> data().size() ) );
+    if ( flush_val ) os.flush();
+   }
+
+  // Print::sink_erased definition
+  PTC_NOINLINE PTC_INLINE void Print::sink_erased( void* sink, void ( *write )( void*, std::string_view, bool ), const erased_arg* args, std::size_t n ) const
+   {
+    const snapshot config( settings_ );
+    auto write_chunk = [ sink, write ]( std::string_view chunk ){ write( sink, chunk, false ); };
+    format_buffer::lease buf;
+    buf -> setFast( config -> fast_format );
+    buf -> setChunkWriter( write_chunk );
+    const bool flush_val = print_erased( *config, *buf, args, n );
+    write( sink, buf -> data(), flush_val );
+   }
+
+  // Print::view_erased definition
+  PTC_NOINLINE PTC_INLINE void Print::view_erased( const erased_arg* args, std::size_t n, void* target, void ( *consume )( void*, std::string_view ) ) const
+   {
+    const snapshot config( settings_ );
+    format_buffer::lease buf;
+    buf -> setFast( config -> fast_format );
+    print_erased( *config, *buf, args, n );
+    consume( target, buf -> data() );
+   }
+
+  // Print::string_erased definition
+  PTC_NOINLINE PTC_INLINE void Print::string_erased( std::string& str, const erased_arg* args, std::size_t n ) const
+   {
+    const snapshot config( settings_ );
+    format_buffer::lease buf;
+    buf -> setFast( config -> fast_format );
+    buf -> data().swap( str );
+    print_erased( *config, *buf, args, n );
+    buf -> data().swap( str );
+   }
+
+  // Print::write_arg definition
+  PTC_INLINE void Print::write_arg( format_buffer& buf, const erased_arg& arg )
+   {
+    if ( ! buf.getFast() && arg.type != arg_type::style && arg.type != arg_type::object )
+     {
+      insert_arg( buf, arg );
+      return;
+     }
+    switch( arg.type )
+     {
+      case arg_type::string: 
+      case arg_type::plain_string: 
+      case arg_type::style: buf.append( std::string_view( arg.value.str, arg.extra.size ) ); break;
+      case arg_type::c_string: buf.write( arg.value.str ); break;
+      case arg_type::character: buf.data().push_back( arg.value.character ); break;
+      case arg_type::boolean: buf.data().push_back( arg.value.boolean ? '1' : '0' ); break;
+      case arg_type::signed_integer: buf.write( arg.value.signed_integer ); break;
+      case arg_type::unsigned_integer: buf.write( arg.value.unsigned_integer ); break;
+      case arg_type::single_float: buf.write( static_cast <float> ( arg.value.floating ) ); break;
+      case arg_type::double_float: buf.write( arg.value.floating ); break;
+      case arg_type::long_float: buf.write( *static_cast <const long double*> ( arg.value.ptr ) ); break;
+      case arg_type::object: arg.extra.write( buf, arg.value.ptr ); break;
+      default: break;
+     }
+   }
+
+  // Print::insert_arg definition
+  PTC_NOINLINE PTC_INLINE void Print::insert_arg( format_buffer& buf, const erased_arg& arg )
+   {
+    switch( arg.type )
+     {
+      case arg_type::string: 
+      case arg_type::plain_string: buf.write( std::string_view( arg.value.str, arg.extra.size ) ); break;
+      case arg_type::c_string: buf.write( arg.value.str ); break;
+      case arg_type::character: buf.write( arg.value.character ); break;
+      case arg_type::boolean: buf.write( arg.value.boolean ); break;
+      case arg_type::signed_integer:
+       {
+        const long long x = arg.value.signed_integer;
+        if ( arg.extra.size == sizeof( short ) ) buf.write( static_cast <short> ( x ) );
+        else if ( arg.extra.size == sizeof( int ) ) buf.write( static_cast <int> ( x ) );
+        else if ( arg.extra.size == sizeof( long ) ) buf.write( static_cast <long> ( x ) );
+        else buf.write( x );
+        break;
+       }
+      case arg_type::unsigned_integer:
+       {
+        const unsigned long long x = arg.value.unsigned_integer;
+        if ( arg.extra.size == sizeof( unsigned short ) ) buf.write( static_cast <unsigned short> ( x ) );
+        else if ( arg.extra.size == sizeof( unsigned ) ) buf.write( static_cast <unsigned> ( x ) );
+        else if ( arg.extra.size == sizeof( unsigned long ) ) buf.write( static_cast <unsigned long> ( x ) );
+        else buf.write( x );
+        break;
+       }
+      case arg_type::single_float: buf.write( static_cast <float> ( arg.value.floating ) ); break;
+      case arg_type::double_float: buf.write( arg.value.floating ); break;
+      case arg_type::long_float: buf.write( *static_cast <const long double*> ( arg.value.ptr ) ); break;
+      default: break;
+     }
+   }
+
+  // Print::is_escape_arg definition
+  PTC_INLINE bool Print::is_escape_arg( const erased_arg& arg, ANSI flag, bool scan )
+   {
+    if ( arg.type == arg_type::style ) return true;
+    else if ( arg.type == arg_type::c_string ) return is_escape( arg.value.str, ANSI( flag ), scan );
+    else if ( arg.type == arg_type::string ) return is_escape( std::string_view( arg.value.str, arg.extra.size ), ANSI( flag ), scan );
+    else if ( arg.type == arg_type::plain_string ) return flag == ANSI::generic && scan && contains_escape( std::string_view( arg.value.str, arg.extra.size ) );
+    return false;
+   }
+
+  // Print::is_null_arg definition
+  PTC_INLINE bool Print::is_null_arg( const erased_arg& arg )
+   {
+    if ( arg.type == arg_type::c_string ) return is_null_str( arg.value.str );
+    else if ( arg.type == arg_type::string ) return arg.extra.size == 0;
+    return false;
+   }
+
+  #endif
  } // end of namespace ptc
 
 #endif
\ No newline at end of file
@@ -0,0 +1,272 @@
+//====================================================
+//     Metadata
+//====================================================
+/**
+ * @file static_print.hpp
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Preprocessor directives
+//====================================================
+#ifndef STATIC_PRINT_HPP
+#define STATIC_PRINT_HPP
+#pragma once
+
+//====================================================
+//     Headers
+//====================================================
+#include "print.hpp"
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace ptc
+ {
+  //====================================================
+  //     Helper tools
+  //====================================================
+
+  // chars
+  /**
+   * @brief Struct used to pass a compile-time string as template argument. Ex: "ptc::chars<',', ' '>" is the string ", ".
+   *
+   * @tparam Cs The characters of the string.
+   */
+  template <char... Cs>
+  struct chars
+   {
+    static constexpr char value[ sizeof...( Cs ) + 1 ] = { Cs..., '\0' };
+    static constexpr std::string_view view{ value, sizeof...( Cs ) };
+   };
+
+  // concat_chars
+  /**
+   * @brief Struct used to concatenate two ptc::chars strings at compile time.
+   * 
+   * @tparam A The first string.
+   * @tparam B The second string.
+   */
+  template <class A, class B>
+  struct concat_chars;
+
+  template <char... As, char... Bs>
+  struct concat_chars <chars<As...>, chars<Bs...>>
+   {
+    using type = chars<As..., Bs...>;
+   };
+
+  //====================================================
+  //     StaticPrint class
+  //====================================================
+  /**
+   * @brief Class used to construct a print function whose separator, end and flush flag are fixed at compile time. It has the same call syntax of the Print class (call options included), but separators are appended as compile-time constants and no configuration is read at run time. Ex: "ptc::StaticPrint<ptc::chars<','>, ptc::chars<'\n'>> csv_print;".
+   *
+   * @tparam Sep The separator, as a ptc::chars string.
+   * @tparam End The end of the line, as a ptc::chars string.
+   * @tparam Flush If true, the stream is flushed after each call.
+   */
+  template <class Sep = chars<' '>, class End = chars<'\n'>, bool Flush = false>
+  class StaticPrint
+   {
+    public:
+
+     //====================================================
+     //     Public getters
+     //====================================================
+
+     // getEnd
+     /**
+      * @brief Getter used to get the value of the "end" variable.
+      *
+      * @return std::string_view The value of the "end" variable.
+      */
+     static constexpr std::string_view getEnd()
+      {
+       return End::view;
+      }
+
+     // getSep
+     /**
+      * @brief Getter used to get the value of the "sep" variable.
+      *
+      * @return std::string_view The value of the "sep" variable.
+      */
+     static constexpr std::string_view getSep()
+      {
+       return Sep::view;
+      }
+
+     // getFlush
+     /**
+      * @brief Getter used to get the value of the "flush" variable.
+      *
+      * @return bool The value of the "flush" variable.
+      */
+     static constexpr bool getFlush()
+      {
+       return Flush;
+      }
+
+     //====================================================
+     //     Public operator () overloads
+     //====================================================
+
+     // General case
+     /**
+      * @brief Frontend implementation of the () operator overload to print to the output stream (or to an output sink).
+      *
+      * @tparam T Generic type of first object to be printed (or the output stream).
+      * @tparam Args Generic type of all the other objects to be printed.
+      * @param first First object to be printed (or the output stream).
+      * @param args The list of all the other objects to be printed.
+      */
+     template <class T, class... Args>
+     void operator()( T&& first, Args&&... args ) const
+      {
+       if constexpr ( std::is_base_of_v <std::ostream, std::remove_reference_t<T>> )
+        {
+         if constexpr( sizeof...( args ) > 0 ) print_backend( first, std::forward<Args>( args )... );
+         else ( *this )( static_cast <std::ostream&> ( first ) );
+        }
+       else if constexpr ( is_sink_v <T> )
+        {
+         format_buffer::lease buf;
+         buf -> setFast( true );
+         const bool flush_val = Print::format_call( *buf, static_config, std::forward<Args>( args )... );
+         first.write( buf -> data(), flush_val );
+        }
+       else
+        {
+         print_backend( std::cout, std::forward<T>( first ), std::forward<Args>( args )... );
+        }
+      }
+
+     // String initialization case
+     /**
+      * @brief Frontend implementation of the () operator overload to initialize an std::string object.
+      *
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param first The mode flag.
+      * @param args The list of all the objects to be printed.
+      * @return const std::string The whole print content in std::string format.
+      */
+     template <class... Args>
+     const std::string operator()( mode&&, Args&&... args ) const
+      {
+       if constexpr( sizeof...( args ) > 0 )
+        {
+         format_buffer::lease buf;
+         buf -> setFast( true );
+         Print::format_call( *buf, static_config, std::forward<Args>( args )... );
+         return buf -> data();
+        }
+       return "";
+      }
+
+     // String target case
+     /**
+      * @brief Frontend implementation of the () operator overload to print into a caller-provided std::string (see ptc::to).
+      *
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param first The target string.
+      * @param args The list of all the objects to be printed.
+      * @return std::size_t The size of the printed content.
+      */
+     template <class... Args>
+     std::size_t operator()( string_target&& first, Args&&... args ) const
+      {
+       first.str.clear();
+       if constexpr( sizeof...( args ) > 0 )
+        {
+         format_buffer::lease buf;
+         buf -> setFast( true );
+         buf -> data().swap( first.str );
+         Print::format_call( *buf, static_config, std::forward<Args>( args )... );
+         buf -> data().swap( first.str );
+        }
+       return first.str.size();
+      }
+
+     #ifdef PTC_MEMORY_RESOURCE
+
+     // Memory resource case
+     /**
+      * @brief Frontend implementation of the () operator overload to print into a new std::pmr::string (see ptc::str_in).
+      *
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param first The memory resource target.
+      * @param args The list of all the objects to be printed.
+      * @return std::pmr::string The whole print content.
+      */
+     template <class... Args>
+     std::pmr::string operator()( resource_target&& first, Args&&... args ) const
+      {
+       std::pmr::string str( first.resource );
+       if constexpr( sizeof...( args ) > 0 )
+        {
+         format_buffer::lease buf;
+         buf -> setFast( true );
+         Print::format_call( *buf, static_config, std::forward<Args>( args )... );
+         str.assign( buf -> data().data(), buf -> data().size() );
+        }
+       return str;
+      }
+
+     #endif
+
+     // No arguments case
+     /**
+      * @brief Operator redefinition used to print an empty line.
+      *
+      * @param os The stream in which you want to print the output.
+      */
+     void operator()( std::ostream& os = std::cout ) const
+      {
+       std::lock_guard <std::mutex> lock{ Print::stream_mutex( os ) };
+       os.write( End::value, static_cast <std::streamsize> ( End::view.size() ) );
+       if constexpr( Flush ) os.flush();
+      }
+
+    private:
+
+     //====================================================
+     //     Private constants
+     //====================================================
+     using end_reset = typename concat_chars <End, chars<'\033', '[', '0', 'm'>>::type;
+     static constexpr Print::call_config static_config{ Sep::view, End::view, Flush, false, end_reset::view };
+
+     //====================================================
+     //     Private methods
+     //====================================================
+
+     // print_backend
+     /**
+      * @brief Backend implementation of the () operator overloads to print to the output stream. The call is formatted into the buffer of the current thread and committed with a single write.
+      *
+      * @tparam T_os The type of the output stream object.
+      * @tparam Args Generic type of all the objects to be printed.
+      * @param os The output stream object.
+      * @param args The list of objects to be printed.
+      */
+     template <class T_os, class... Args>
+     void print_backend( T_os& os, Args&&... args ) const
+      {
+       format_buffer::lease buf;
+       buf -> copy_format( os, true );
+       const bool flush_val = Print::format_call( *buf, static_config, std::forward<Args>( args )... );
+
+       std::lock_guard <std::mutex> lock{ Print::stream_mutex( os ) };
+       os.write( buf -> data().data(), static_cast <std::streamsize> ( buf -> data().size() ) );
+       if ( flush_val && ! std::is_base_of_v <std::ostringstream, T_os> ) os.flush();
+      }
+   }; // end of StaticPrint class
+ } // end of namespace ptc
+
+#endif
@@ -0,0 +1,34 @@
+//====================================================
+//     Metadata
+//====================================================
+/**
+ * @file print.cpp
+ * @author Gianluca Bianco (biancogianluca9@gmail.com)
+ * @date 2022-07-14
+ * @copyright Copyright (c) 2022 Gianluca Bianco under the MIT license.
+ */
+
+//====================================================
+//     Preprocessor directives
+//====================================================
+#ifndef PTC_SEPARATE_COMPILATION
+ #error "src/print.cpp must be compiled with PTC_SEPARATE_COMPILATION defined, as the code which uses it."
+#endif
+#define PTC_SOURCE
+
+//====================================================
+//     Headers
+//====================================================
+#include "../include/ptc/print.hpp"
+
+namespace ptc
+ {
+  //====================================================
+  //     Explicit instantiations
+  //====================================================
+  template void Print::write_object <std::nullptr_t>( format_buffer&, const void* );
+  template void Print::write_object <std::complex <double>>( format_buffer&, const void* );
+  template void Print::write_object <std::vector <int>>( format_buffer&, const void* );
+  template void Print::write_object <std::vector <double>>( format_buffer&, const void* );
+  template void Print::write_object <std::vector <std::string>>( format_buffer&, const void* );
+ }
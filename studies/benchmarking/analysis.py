@@ -14,7 +14,10 @@ import argparse as ap
 from termcolor import colored as cl
 import pandas as pd
 import json
+import math
 import os
+import re
+import sys
 
 #################################################
 #     set_y_label
@@ -106,6 +109,151 @@ def get_feature_name( name ):
     elif "file" in name:
         return "writing to file"
 
+#################################################
+#     get_repetitions
+#################################################
+def get_repetitions( data, time_type ):
+    """
+    Function used to collect the single repetitions of each benchmark, skipping the aggregates.
+
+    Args:
+        data (dict): the loaded benchmark dataset.
+        time_type (str): the data time-type.
+
+    Returns:
+        dict: the list of repetition times of each benchmark, keyed by benchmark name.
+    
+    Testing:
+        >>> data = { "benchmarks": [
+        ...     { "name": "ptc_print_str", "run_name": "ptc_print_str", "run_type": "iteration", "real_time": 1.0 },
+        ...     { "name": "ptc_print_str", "run_name": "ptc_print_str", "run_type": "iteration", "real_time": 2.0 },
+        ...     { "name": "ptc_print_str_mean", "run_name": "ptc_print_str", "run_type": "aggregate", "real_time": 1.5 } ] }
+        >>> get_repetitions( data, "real_time" )
+        {'ptc_print_str': [1.0, 2.0]}
+    """
+    
+    repetitions = {}
+    for d in data[ "benchmarks" ]:
+        if d.get( "run_type", "iteration" ) != "iteration" or "error_occurred" in d:
+            continue
+        repetitions.setdefault( d.get( "run_name", d[ "name" ] ), [] ).append( d[ time_type ] )
+    
+    return repetitions
+
+#################################################
+#     mann_whitney
+#################################################
+def mann_whitney( baseline, candidate ):
+    """
+    Function used to perform a one-sided Mann-Whitney U test, with the alternative hypothesis that candidate values are larger than baseline ones. The normal approximation with tie and continuity corrections is used.
+
+    Args:
+        baseline (list): the baseline sample.
+        candidate (list): the candidate sample.
+
+    Returns:
+        float: the p-value of the test.
+    
+    Testing:
+        >>> round( mann_whitney( [ 1, 2, 3, 4, 5 ], [ 6, 7, 8, 9, 10 ] ), 4 )
+        0.0061
+        >>> round( mann_whitney( [ 6, 7, 8, 9, 10 ], [ 1, 2, 3, 4, 5 ] ), 4 )
+        0.9967
+        >>> mann_whitney( [ 1, 1, 1 ], [ 1, 1, 1 ] )
+        1.0
+    """
+    
+    # Ranking the pooled sample, averaging ties
+    pooled = sorted( [ ( value, 0 ) for value in baseline ] + [ ( value, 1 ) for value in candidate ] )
+    n1, n2 = len( baseline ), len( candidate )
+    n = n1 + n2
+    rank_sum, ties, i = 0.0, 0.0, 0
+    while i < n:
+        j = i
+        while j < n and pooled[ j ][ 0 ] == pooled[ i ][ 0 ]:
+            j += 1
+        rank = ( i + j + 1 ) / 2
+        rank_sum += rank * sum( 1 for k in range( i, j ) if pooled[ k ][ 1 ] == 1 )
+        ties += ( j - i ) ** 3 - ( j - i )
+        i = j
+    
+    # Normal approximation of the candidate U statistic
+    u = rank_sum - n2 * ( n2 + 1 ) / 2
+    sigma = math.sqrt( n1 * n2 / 12 * ( ( n + 1 ) - ties / ( n * ( n - 1 ) ) ) )
+    if sigma == 0:
+        return 1.0
+    z = ( u - n1 * n2 / 2 - 0.5 ) / sigma
+    
+    return 0.5 * math.erfc( z / math.sqrt( 2 ) )
+
+#################################################
+#     median
+#################################################
+def median( values ):
+    """
+    Function used to compute the median of a sample.
+
+    Args:
+        values (list): the input sample.
+
+    Returns:
+        float: the median of the sample.
+    
+    Testing:
+        >>> median( [ 3, 1, 2 ] )
+        2
+        >>> median( [ 4, 1, 2, 3 ] )
+        2.5
+    """
+    
+    values = sorted( values )
+    middle = len( values ) // 2
+    if len( values ) % 2:
+        return values[ middle ]
+    return ( values[ middle - 1 ] + values[ middle ] ) / 2
+
+#################################################
+#     Comparator
+#################################################
+def comparator( baseline, candidate, time_type ):
+    """
+    Function used to compare a candidate benchmark run against a baseline one. A benchmark is a regression if the candidate is significantly slower according to the Mann-Whitney test and if its median slowdown is larger than the threshold.
+
+    Args:
+        baseline (json file): the baseline dataset.
+        candidate (json file): the candidate dataset.
+        time_type (str): the data time-type.
+
+    Returns:
+        list: the comparison result of each benchmark matching the filter.
+    """
+    
+    # Loading data
+    with open( baseline ) as f:
+        baseline = get_repetitions( json.load( f ), time_type )
+    with open( candidate ) as f:
+        candidate = get_repetitions( json.load( f ), time_type )
+    
+    # Comparing benchmarks
+    results = []
+    for name in sorted( baseline.keys() & candidate.keys() ):
+        if not re.search( args.filter, name ):
+            continue
+        old, new = baseline[ name ], candidate[ name ]
+        change = median( new ) / median( old ) - 1 if median( old ) else 0.0
+        p_value = mann_whitney( old, new ) if min( len( old ), len( new ) ) > 1 else 1.0
+        results.append( {
+            "name": name,
+            "time_type": time_type,
+            "baseline_median": median( old ),
+            "candidate_median": median( new ),
+            "change": change,
+            "p_value": p_value,
+            "regression": p_value < args.alpha and change > args.threshold
+        } )
+    
+    return results
+
 #################################################
 #     Plotter
 #################################################
@@ -175,6 +323,26 @@ def plotter( data, time_type ):
 #     Main
 #################################################
 def main():
+    
+    # Comparing against a baseline
+    if args.baseline:
+        results = comparator( args.baseline, args.data, "real_time" ) + comparator( args.baseline, args.data, "cpu_time" )
+        for r in results:
+            color = "red" if r[ "regression" ] else "green"
+            print( cl( "{:<60} {:<9} {:>+8.2%}  p = {:.4f}".format( r[ "name" ], r[ "time_type" ], r[ "change" ], r[ "p_value" ] ), color ) )
+        regressions = sorted( { r[ "name" ] for r in results if r[ "regression" ] } )
+        if args.summary:
+            with open( args.summary, "w" ) as f:
+                json.dump( { "alpha": args.alpha, "threshold": args.threshold, "regressions": regressions, "benchmarks": results }, f, indent = 2 )
+        if not results:
+            print( cl( "No benchmark matching \"{}\" is shared by the two datasets!".format( args.filter ), "red" ) )
+            sys.exit( 2 )
+        if regressions:
+            print( cl( "{} regression(s) found.".format( len( regressions ) ), "red" ) )
+            sys.exit( 1 )
+        return
+    
+    # Plotting
     plotter( args.data, "real_time" )
     plotter( args.data, "cpu_time" )
 
@@ -186,6 +354,11 @@ if __name__ == "__main__":
     parser.add_argument( "--data", default = "data/benchmarking.json", help = "The input dataset." )
     parser.add_argument( "--save", default = "no", help = "Save the produced plots or not (yes / no)." )
     parser.add_argument( "--macro", default = "no", help = "Preprocessor macro usage (yes / no)." )
+    parser.add_argument( "--baseline", default = "", help = "Baseline dataset: if set, --data is compared against it instead of being plotted." )
+    parser.add_argument( "--filter", default = "^ptc_print_", help = "Regex selecting the benchmarks to compare." )
+    parser.add_argument( "--alpha", default = 0.05, type = float, help = "Significance level of the Mann-Whitney test." )
+    parser.add_argument( "--threshold", default = 0.05, type = float, help = "Minimum relative median slowdown considered a regression." )
+    parser.add_argument( "--summary", default = "", help = "Output file of the JSON comparison summary." )
     args = parser.parse_args()
     
     # Main commands
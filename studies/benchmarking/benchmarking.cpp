@@ -3,6 +3,13 @@
 //====================================================
 // My headers
 #include "../../include/ptc/print.hpp"
+#include "../../include/ptc/static_print.hpp"
+#include "../../include/ptc/parallel_print.hpp"
+#include "../../include/ptc/file_sink.hpp"
+#include "../../include/ptc/mmap_sink.hpp"
+#include "../../include/ptc/binary_log.hpp"
+#include "../../include/ptc/basic_print.hpp"
+#include "../../include/ptc/fixed_print.hpp"
 
 // Headers for comparison
 #include <fmt/core.h>
@@ -17,12 +24,47 @@
 #include <fstream>
 #include <complex>
 #include <vector>
+#include <cstdio>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
 
 //====================================================
 //     Namespace directives
 //====================================================
 namespace bm = benchmark;
 
+//====================================================
+//     Helper tools
+//====================================================
+
+// null_buffer
+/**
+ * @brief Class used to discard the output of a stream, so that only the cost of formatting and locking is measured.
+ * 
+ */
+class null_buffer: public std::streambuf
+ {
+  protected:
+   int overflow( int c ) override { return traits_type::not_eof( c ); }
+   std::streamsize xsputn( const char*, std::streamsize n ) override { return n; }
+ };
+
+// print_args
+/**
+ * @brief Function used to print N copies of the same argument, so that the number of arguments can be swept at run time.
+ * 
+ * @tparam Is The indices of the arguments.
+ * @param str The target string.
+ */
+template <std::size_t... Is>
+void print_args( std::string& str, std::index_sequence<Is...> )
+ {
+  ptc::print( ptc::to( str ), ( static_cast <void> ( Is ), "arg" )... );
+ }
+
 //====================================================
 //     ptc::print setters
 //====================================================
@@ -31,18 +73,21 @@ namespace bm = benchmark;
 static void ptc_print_setSep( bm::State& state ) 
  {
   for ( auto _ : state ) ptc::print.setSep( "*" );
+  ptc::print.setSep( " " );
  }
 
 // ptc_print_setEnd
 static void ptc_print_setEnd( bm::State& state ) 
  {
   for ( auto _ : state ) ptc::print.setEnd( "." );
+  ptc::print.setEnd( "\n" );
  }
 
 // ptc_print_setFlush
 static void ptc_print_setFlush( bm::State& state ) 
  {
   for ( auto _ : state ) ptc::print.setFlush( true );
+  ptc::print.setFlush( false );
  }
 
 //====================================================
@@ -83,6 +128,117 @@ static void ptc_print_str( bm::State& state )
   for ( auto _ : state ) bm::DoNotOptimize( ptc::print( ptc::mode::str, "Testing", 123, "print", '!' ) );
  }
 
+// ptc_static_print_str
+static void ptc_static_print_str( bm::State& state ) 
+ {
+  const ptc::StaticPrint <> static_print;
+  for ( auto _ : state ) bm::DoNotOptimize( static_print( ptc::mode::str, "Testing", 123, "print", '!' ) );
+ }
+
+// ptc_print_str_options
+static void ptc_print_str_options( bm::State& state ) 
+ {
+  for ( auto _ : state ) bm::DoNotOptimize( ptc::print( ptc::mode::str, "Testing", 123, "print", '!', ptc::sep( "*" ), ptc::end( "" ) ) );
+ }
+
+// ptc_print_str_style
+static void ptc_print_str_style( bm::State& state ) 
+ {
+  std::string str;
+  for ( auto _ : state ) ptc::print( ptc::to( str ), ptc::style::red, "Testing", 123, "print", '!' );
+ }
+
+// ptc_print_str_setters
+static void ptc_print_str_setters( bm::State& state ) 
+ {
+  for ( auto _ : state ) 
+   {
+    ptc::print.setSep( "*" );
+    ptc::print.setEnd( "" );
+    bm::DoNotOptimize( ptc::print( ptc::mode::str, "Testing", 123, "print", '!' ) );
+    ptc::print.setSep( " " );
+    ptc::print.setEnd( "\n" );
+   }
+ }
+
+// ptc_wprint_str
+static void ptc_wprint_str( bm::State& state ) 
+ {
+  for ( auto _ : state ) bm::DoNotOptimize( ptc::wprint( ptc::mode::str, L"Testing", 123, "print", L'!' ) );
+ }
+
+// ptc_wprint_wstream
+static void ptc_wprint_wstream( bm::State& state ) 
+ {
+  std::wostringstream wstream;
+  for ( auto _ : state ) 
+   {
+    ptc::wprint( wstream, L"Testing", 123, "print", L'!' );
+    wstream.str( L"" );
+   }
+ }
+
+#ifdef PTC_MEMORY_RESOURCE
+// ptc_print_str_arena
+static void ptc_print_str_arena( bm::State& state ) 
+ {
+  const std::string payload( 64, 'x' );
+  std::pmr::monotonic_buffer_resource arena( 1 << 16 );
+  unsigned requests = 0;
+  for ( auto _ : state ) 
+   {
+    bm::DoNotOptimize( ptc::print( ptc::str_in( arena ), "Testing", 123, payload ) );
+    if ( ++requests % 256 == 0 ) arena.release();
+   }
+ }
+#endif
+
+// ptc_print_str_payload
+static void ptc_print_str_payload( bm::State& state ) 
+ {
+  const std::string payload( 64, 'x' );
+  for ( auto _ : state ) bm::DoNotOptimize( ptc::print( ptc::mode::str, "Testing", 123, payload ) );
+ }
+
+// ptc_print_to_string
+static void ptc_print_to_string( bm::State& state ) 
+ {
+  std::string str;
+  for ( auto _ : state ) bm::DoNotOptimize( ptc::print( ptc::to( str ), "Testing", 123, "print", '!' ) );
+ }
+
+// ptc_print_to_buffer
+static void ptc_print_to_buffer( bm::State& state ) 
+ {
+  char buf[ 64 ];
+  for ( auto _ : state ) bm::DoNotOptimize( ptc::print( ptc::to( buf, sizeof( buf ) ), "Testing", 123, "print", '!' ) );
+ }
+
+// ptc_fixed_print_to_buffer
+static void ptc_fixed_print_to_buffer( bm::State& state ) 
+ {
+  const ptc::FixedPrint <> fixed_print;
+  char buf[ 64 ];
+  for ( auto _ : state ) bm::DoNotOptimize( fixed_print( ptc::to( buf, sizeof( buf ) ), "Testing", 123, "print", '!' ) );
+ }
+
+// ptc_print_str_long
+static void ptc_print_str_long( bm::State& state ) 
+ {
+  const std::string payload( 4096, 'x' );
+  ptc::print.setEscapeScan( state.range( 0 ) );
+  for ( auto _ : state ) bm::DoNotOptimize( ptc::print( ptc::mode::str, "Payload:", payload ) );
+  ptc::print.setEscapeScan( false );
+ }
+
+// ptc_print_str_numbers
+static void ptc_print_str_numbers( bm::State& state ) 
+ {
+  ptc::print.setFastFormatting( state.range( 0 ) );
+  for ( auto _ : state ) bm::DoNotOptimize( ptc::print( ptc::mode::str, 123456789, -42, 3.14159, 2.5e-8 ) );
+  ptc::print.setFastFormatting( true );
+ }
+
 //====================================================
 //      ptc::print non built-in types 
 //====================================================
@@ -101,6 +257,38 @@ static void ptc_print_vector( bm::State& state )
   for ( auto _ : state ) ptc::print( vec );
  }
 
+// ptc_print_int_array
+static void ptc_print_int_array( bm::State& state ) 
+ {
+  std::vector <int> vec( 1 << 16 );
+  for ( std::size_t i = 0; i < vec.size(); ++i ) vec[ i ] = static_cast <int> ( i * 2654435761u );
+  std::string str;
+  for ( auto _ : state ) ptc::print( ptc::to( str ), vec );
+  state.SetItemsProcessed( state.iterations() * vec.size() );
+ }
+
+// ptc_print_int_array_parallel
+static void ptc_print_int_array_parallel( bm::State& state ) 
+ {
+  std::vector <int> vec( 1 << 22 );
+  for ( std::size_t i = 0; i < vec.size(); ++i ) vec[ i ] = static_cast <int> ( i * 2654435761u );
+  std::string str;
+  ptc::print.setParallel( static_cast <unsigned> ( state.range( 0 ) ) );
+  for ( auto _ : state ) ptc::print( ptc::to( str ), vec );
+  ptc::print.setParallel( 1 );
+  state.SetItemsProcessed( state.iterations() * vec.size() );
+ }
+
+// ptc_print_double_array
+static void ptc_print_double_array( bm::State& state ) 
+ {
+  std::vector <double> vec( 1 << 16 );
+  for ( std::size_t i = 0; i < vec.size(); ++i ) vec[ i ] = static_cast <double> ( i ) / 7.0;
+  std::string str;
+  for ( auto _ : state ) ptc::print( ptc::to( str ), vec );
+  state.SetItemsProcessed( state.iterations() * vec.size() );
+ }
+
 //====================================================
 //      stdout
 //====================================================
@@ -111,6 +299,14 @@ static void ptc_print_stdout( bm::State& state )
   for ( auto _ : state ) ptc::print( "Testing", 123, "print", '!' );
  }
 
+// ptc_print_stdout_buffered
+static void ptc_print_stdout_buffered( bm::State& state ) 
+ {
+  ptc::print.setBuffer( 1 << 16 );
+  for ( auto _ : state ) ptc::print( "Testing", 123, "print", '!' );
+  ptc::print.setBuffer( 0 );
+ }
+
 // fmt_print_stdout
 static void fmt_print_stdout( bm::State& state ) 
  {
@@ -142,6 +338,43 @@ static void ptc_print_file( bm::State& state )
   file_stream.close();
  }
 
+// ptc_print_file_sink
+static void ptc_print_file_sink( bm::State& state ) 
+ {
+  std::remove( "test.txt" );
+  ptc::FileSink sink( "test.txt", state.range( 0 ) );
+  for ( auto _ : state ) ptc::print( sink, "Testing", 123, "print", '!' );
+ }
+
+// ptc_print_large_vector
+static void ptc_print_large_vector( bm::State& state ) 
+ {
+  std::vector <int> vec( 1 << 20, 123 );
+  ptc::FileSink sink( "test.txt" );
+  for ( auto _ : state ) ptc::print( sink, vec );
+  std::remove( "test.txt" );
+ }
+
+// ptc_print_mmap_sink
+static void ptc_print_mmap_sink( bm::State& state ) 
+ {
+   {
+    ptc::MmapSink sink( "test.log" );
+    for ( auto _ : state ) ptc::print( sink, "Testing", 123, "print", '!' );
+   }
+  for ( int i = 0; std::remove( ( "test.log." + std::to_string( i ) ).c_str() ) == 0; ++i );
+ }
+
+// ptc_binary_log
+static void ptc_binary_log( bm::State& state ) 
+ {
+   {
+    ptc::BinaryLog log( "test.bin" );
+    for ( auto _ : state ) log( "Testing", 123, "print", '!' );
+   }
+  std::remove( "test.bin" );
+ }
+
 // std_file
 static void std_file( bm::State& state ) 
  {
@@ -154,31 +387,198 @@ static void std_file( bm::State& state )
 // fmt_print_file
 static void fmt_print_file( bm::State& state ) 
  {
-  auto out = fmt::output_file( "test.txt", std::ios::trunc );
+  auto out = fmt::output_file( "test.txt" );
   for ( auto _ : state ) out.print( "Testing {} {} {}\n", 123, "print", '!' );
  }
 
+//====================================================
+//      Sweeps
+//====================================================
+
+// ptc_print_args_sweep
+static void ptc_print_args_sweep( bm::State& state ) 
+ {
+  std::string str;
+  const auto n_args = state.range( 0 );
+  for ( auto _ : state ) 
+   {
+    switch( n_args )
+     {
+      case 1: print_args( str, std::make_index_sequence<1>{} ); break;
+      case 2: print_args( str, std::make_index_sequence<2>{} ); break;
+      case 4: print_args( str, std::make_index_sequence<4>{} ); break;
+      case 8: print_args( str, std::make_index_sequence<8>{} ); break;
+      case 16: print_args( str, std::make_index_sequence<16>{} ); break;
+      default: print_args( str, std::make_index_sequence<32>{} ); break;
+     }
+    bm::DoNotOptimize( str.data() );
+   }
+  state.SetItemsProcessed( state.iterations() * n_args );
+ }
+
+// ptc_print_string_sweep
+static void ptc_print_string_sweep( bm::State& state ) 
+ {
+  const std::string payload( static_cast <std::size_t> ( state.range( 0 ) ), 'x' );
+  std::string str;
+  for ( auto _ : state ) ptc::print( ptc::to( str ), "Payload:", payload );
+  state.SetBytesProcessed( state.iterations() * static_cast <int64_t> ( str.size() ) );
+ }
+
+// ptc_print_container_sweep
+static void ptc_print_container_sweep( bm::State& state ) 
+ {
+  std::vector <int> vec( static_cast <std::size_t> ( state.range( 0 ) ) );
+  for ( std::size_t i = 0; i < vec.size(); ++i ) vec[ i ] = static_cast <int> ( i * 2654435761u );
+  std::string str;
+  for ( auto _ : state ) ptc::print( ptc::to( str ), vec );
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+  state.SetBytesProcessed( state.iterations() * static_cast <int64_t> ( str.size() ) );
+ }
+
+//====================================================
+//      Sinks
+//====================================================
+
+// ptc_print_ostringstream
+static void ptc_print_ostringstream( bm::State& state ) 
+ {
+  std::ostringstream stream;
+  std::size_t bytes = 0;
+  for ( auto _ : state ) 
+   {
+    ptc::print( stream, "Testing", 123, "print", '!' );
+    if ( stream.tellp() > ( 1 << 20 ) ) 
+     {
+      bytes += static_cast <std::size_t> ( stream.tellp() );
+      stream.str( "" );
+     }
+   }
+  bytes += static_cast <std::size_t> ( stream.tellp() );
+  state.SetBytesProcessed( static_cast <int64_t> ( bytes ) );
+ }
+
+// ptc_print_ofstream
+static void ptc_print_ofstream( bm::State& state ) 
+ {
+  std::ofstream file_stream( "test.txt", std::ios::trunc );
+  for ( auto _ : state ) ptc::print( file_stream, "Testing", 123, "print", '!' );
+  state.SetBytesProcessed( static_cast <int64_t> ( file_stream.tellp() ) );
+  file_stream.close();
+  std::remove( "test.txt" );
+ }
+
+// ptc_print_devnull_ofstream
+static void ptc_print_devnull_ofstream( bm::State& state ) 
+ {
+  std::ofstream null_stream( "/dev/null" );
+  for ( auto _ : state ) ptc::print( null_stream, "Testing", 123, "print", '!' );
+  state.SetBytesProcessed( state.iterations() * 20 );
+ }
+
+// ptc_print_devnull_fd
+static void ptc_print_devnull_fd( bm::State& state ) 
+ {
+  const int fd = ::open( "/dev/null", O_WRONLY );
+   {
+    ptc::FileSink sink( fd, static_cast <std::size_t> ( state.range( 0 ) ) );
+    for ( auto _ : state ) ptc::print( sink, "Testing", 123, "print", '!' );
+   }
+  ::close( fd );
+  state.SetBytesProcessed( state.iterations() * 20 );
+ }
+
+//====================================================
+//      Contention
+//====================================================
+
+// ptc_print_contention_shared
+static void ptc_print_contention_shared( bm::State& state ) 
+ {
+  static null_buffer buffer;
+  static std::ostream shared_stream( &buffer );
+  for ( auto _ : state ) ptc::print( shared_stream, "Testing", 123, "print", '!' );
+  state.SetItemsProcessed( state.iterations() );
+ }
+
+// ptc_print_contention_private
+static void ptc_print_contention_private( bm::State& state ) 
+ {
+  null_buffer buffer;
+  std::ostream private_stream( &buffer );
+  for ( auto _ : state ) ptc::print( private_stream, "Testing", 123, "print", '!' );
+  state.SetItemsProcessed( state.iterations() );
+ }
+
+// ptc_print_contention_str
+static void ptc_print_contention_str( bm::State& state ) 
+ {
+  std::string str;
+  for ( auto _ : state ) ptc::print( ptc::to( str ), "Testing", 123, "print", '!' );
+  state.SetItemsProcessed( state.iterations() );
+ }
+
+// ptc_print_contention_fd
+static void ptc_print_contention_fd( bm::State& state ) 
+ {
+  static ptc::FileSink sink( "/dev/null" );
+  for ( auto _ : state ) ptc::print( sink, "Testing", 123, "print", '!' );
+  state.SetItemsProcessed( state.iterations() );
+ }
+
+// std_cout_contention_shared
+static void std_cout_contention_shared( bm::State& state ) 
+ {
+  static null_buffer buffer;
+  static std::ostream shared_stream( &buffer );
+  static std::mutex mutex;
+  for ( auto _ : state ) 
+   {
+    std::lock_guard <std::mutex> lock{ mutex };
+    shared_stream << "Testing " << 123 << " print " << '!' << "\n";
+   }
+  state.SetItemsProcessed( state.iterations() );
+ }
+
 //====================================================
 //     ptc::print methods
 //====================================================
 
 // ptc::print setters
-//BENCHMARK( ptc_print_setEnd );
-//BENCHMARK( ptc_print_setSep );
-//BENCHMARK( ptc_print_setFlush );
+BENCHMARK( ptc_print_setEnd );
+BENCHMARK( ptc_print_setSep );
+BENCHMARK( ptc_print_setFlush );
 
 // ptc::print getters
-//BENCHMARK( ptc_print_getEnd );
-//BENCHMARK( ptc_print_getSep );
-//BENCHMARK( ptc_print_getFlush );
+BENCHMARK( ptc_print_getEnd );
+BENCHMARK( ptc_print_getSep );
+BENCHMARK( ptc_print_getFlush );
 
 // ptc::print other 
-//BENCHMARK( ptc_print_standard );
-//BENCHMARK( ptc_print_str );
+BENCHMARK( ptc_print_standard );
+BENCHMARK( ptc_print_str );
+BENCHMARK( ptc_print_str_options );
+BENCHMARK( ptc_print_str_style );
+BENCHMARK( ptc_print_str_setters );
+BENCHMARK( ptc_static_print_str );
+BENCHMARK( ptc_wprint_str );
+BENCHMARK( ptc_wprint_wstream );
+BENCHMARK( ptc_print_to_string );
+BENCHMARK( ptc_print_str_payload );
+#ifdef PTC_MEMORY_RESOURCE
+BENCHMARK( ptc_print_str_arena );
+#endif
+BENCHMARK( ptc_print_to_buffer );
+BENCHMARK( ptc_fixed_print_to_buffer );
+BENCHMARK( ptc_print_str_long )->Arg( 0 )->Arg( 1 );
+BENCHMARK( ptc_print_str_numbers )->Arg( 1 )->Arg( 0 );
 
 // non built-in types
-//BENCHMARK( ptc_print_complex );
-//BENCHMARK( ptc_print_vector );
+BENCHMARK( ptc_print_complex );
+BENCHMARK( ptc_print_vector );
+BENCHMARK( ptc_print_int_array );
+BENCHMARK( ptc_print_int_array_parallel )->Arg( 1 )->Arg( 4 )->UseRealTime();
+BENCHMARK( ptc_print_double_array );
 
 //====================================================
 //     Comparison with other libraries
@@ -186,13 +586,40 @@ static void fmt_print_file( bm::State& state )
 
 // stdout
 BENCHMARK( ptc_print_stdout );
-//BENCHMARK( fmt_print_stdout ) ;
-//BENCHMARK( std_cout_stdout ) ;
-//BENCHMARK( printf_stdout );
+BENCHMARK( ptc_print_stdout_buffered );
+BENCHMARK( fmt_print_stdout );
+BENCHMARK( std_cout_stdout );
+BENCHMARK( printf_stdout );
 
 // file writing
-//BENCHMARK( ptc_print_file );
-//BENCHMARK( fmt_print_file );
-//BENCHMARK( std_file );
+BENCHMARK( ptc_print_file );
+BENCHMARK( ptc_print_file_sink )->Arg( 0 )->Arg( 1 << 15 );
+BENCHMARK( ptc_print_mmap_sink );
+BENCHMARK( ptc_print_large_vector );
+BENCHMARK( ptc_binary_log );
+BENCHMARK( fmt_print_file );
+BENCHMARK( std_file );
+
+//====================================================
+//     Sweeps, sinks and contention
+//====================================================
+
+// Sweeps over argument count, string length and container size
+BENCHMARK( ptc_print_args_sweep )->RangeMultiplier( 2 )->Range( 1, 32 );
+BENCHMARK( ptc_print_string_sweep )->RangeMultiplier( 8 )->Range( 8, 1 << 18 );
+BENCHMARK( ptc_print_container_sweep )->RangeMultiplier( 8 )->Range( 8, 1 << 21 );
+
+// Sinks
+BENCHMARK( ptc_print_ostringstream );
+BENCHMARK( ptc_print_ofstream );
+BENCHMARK( ptc_print_devnull_ofstream );
+BENCHMARK( ptc_print_devnull_fd )->Arg( 0 )->Arg( 1 << 15 );
+
+// Contention
+BENCHMARK( ptc_print_contention_shared )->ThreadRange( 1, 64 )->UseRealTime();
+BENCHMARK( ptc_print_contention_private )->ThreadRange( 1, 64 )->UseRealTime();
+BENCHMARK( ptc_print_contention_str )->ThreadRange( 1, 64 )->UseRealTime();
+BENCHMARK( ptc_print_contention_fd )->ThreadRange( 1, 64 )->UseRealTime();
+BENCHMARK( std_cout_contention_shared )->ThreadRange( 1, 64 )->UseRealTime();
 
 BENCHMARK_MAIN();
\ No newline at end of file
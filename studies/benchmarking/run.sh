@@ -1,6 +1,7 @@
 #!/bin/bash
 
 # $1 = "macro": run benchmarks with macro options enabled.
+# $2 = baseline dataset: compare the generated data against it, failing on regressions.
 
 # Creating directories
 mkdir -p data
@@ -17,7 +18,7 @@ sudo cpupower frequency-set --governor performance > /dev/null 2>&1
 --benchmark_out=data/benchmarking.json \
 --benchmark_repetitions=15 \
 --benchmark_display_aggregates_only=true \
---benchmark_report_aggregates_only=true
+--benchmark_report_aggregates_only=false
 sudo cpupower frequency-set --governor powersave > /dev/null 2>&1
 
 # Extra option for macro usage
@@ -26,6 +27,16 @@ if [ "$1" == "macro" ] ; then
     sed -i '4d' benchmarking.cpp
 fi
 
+# Comparing data with the baseline
+if [ -n "$2" ] ; then
+    ./analysis.py \
+    --tests=on \
+    --data=data/benchmarking.json \
+    --baseline="$2" \
+    --summary=data/comparison.json
+    exit $?
+fi
+
 # Analyzing data
 ./analysis.py \
 --tests=on \
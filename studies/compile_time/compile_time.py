@@ -0,0 +1,464 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Compile-time, executable size and runtime study of ptc::print, compared with fmt::print and printf.
+"""
+
+#################################################
+#     Modules
+#################################################
+import argparse as ap
+import doctest
+import itertools
+import json
+import os
+import random
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+#################################################
+#     Types pool
+#################################################
+
+# Scalar types: ( C++ type, value, printf specifier, printf argument )
+SCALARS = [
+    ( "int", "-42", "%d", "{}" ),
+    ( "long", "1234567890L", "%ld", "{}" ),
+    ( "unsigned", "7u", "%u", "{}" ),
+    ( "double", "3.14159", "%g", "{}" ),
+    ( "float", "2.5f", "%g", "static_cast <double> ( {} )" ),
+    ( "char", "'c'", "%c", "{}" ),
+    ( "const char*", "\"text\"", "%s", "{}" ),
+    ( "std::string", "\"string\"", "%s", "{}.c_str()" )
+]
+
+# Container types: ( C++ type, value )
+CONTAINERS = [
+    ( "std::vector <int>", "{ 1, 2, 3 }" ),
+    ( "std::vector <std::string>", "{ \"a\", \"b\" }" ),
+    ( "std::map <int, std::string>", "{ { 1, \"one\" } }" ),
+    ( "std::pair <int, double>", "{ 1, 2.0 }" )
+]
+
+#################################################
+#     variable_name
+#################################################
+def variable_name( index ):
+    """
+    Function used to get the name of the global variable of a type of the pool.
+
+    Args:
+        index (int): the index of the type in the pool.
+
+    Returns:
+        str: the variable name.
+
+    Testing:
+        >>> variable_name( 3 )
+        'v3'
+    """
+
+    return "v{}".format( index )
+
+#################################################
+#     get_signatures
+#################################################
+def get_signatures( pool_size, count, max_arity, seed = 0 ):
+    """
+    Function used to get a reproducible list of distinct call signatures, i.e. of tuples of type indices.
+
+    Args:
+        pool_size (int): the number of types in the pool.
+        count (int): the number of signatures.
+        max_arity (int): the maximum number of arguments of a call.
+        seed (int): the shuffling seed.
+
+    Returns:
+        list: the list of signatures.
+
+    Testing:
+        >>> len( get_signatures( 3, 10, 2 ) )
+        10
+        >>> len( set( get_signatures( 3, 12, 2 ) ) )
+        12
+        >>> get_signatures( 2, 10, 1 )
+        Traceback (most recent call last):
+        ...
+        RuntimeError: Only 2 distinct signatures are available, 10 requested!
+    """
+
+    signatures = []
+    for arity in range( 1, max_arity + 1 ):
+        signatures += list( itertools.product( range( pool_size ), repeat = arity ) )
+    if len( signatures ) < count:
+        raise RuntimeError( "Only {} distinct signatures are available, {} requested!".format( len( signatures ), count ) )
+    random.Random( seed ).shuffle( signatures )
+
+    return signatures[ :count ]
+
+#################################################
+#     call
+#################################################
+def call( library, signature, pool ):
+    """
+    Function used to generate the printing statement of a signature.
+
+    Args:
+        library (str): the printing library (ptc / ptc_separate / ptc_erased / fmt / printf).
+        signature (tuple): the type indices of the arguments.
+        pool (list): the types pool.
+
+    Returns:
+        str: the printing statement.
+
+    Testing:
+        >>> call( "ptc", ( 0, 6 ), SCALARS )
+        'ptc::print( v0, v6 );'
+        >>> call( "fmt", ( 0, 6 ), SCALARS )
+        'fmt::print( "{} {}\\\\n", v0, v6 );'
+        >>> call( "printf", ( 0, 7 ), SCALARS )
+        'std::printf( "%d %s\\\\n", v0, v7.c_str() );'
+    """
+
+    names = [ variable_name( i ) for i in signature ]
+    if library in ( "ptc", "ptc_separate", "ptc_erased" ):
+        return "ptc::print( {} );".format( ", ".join( names ) )
+    elif library == "fmt":
+        return "fmt::print( \"{}\\n\", {} );".format( " ".join( [ "{}" ] * len( names ) ), ", ".join( names ) )
+    elif library == "printf":
+        specifiers = " ".join( pool[ i ][ 2 ] for i in signature )
+        arguments = ", ".join( pool[ i ][ 3 ].format( variable_name( i ) ) for i in signature )
+        return "std::printf( \"{}\\n\", {} );".format( specifiers, arguments )
+    raise RuntimeError( "Library \"{}\" is not supported!".format( library ) )
+
+#################################################
+#     generate
+#################################################
+def generate( directory, library, units, calls, pool, max_arity ):
+    """
+    Function used to generate the translation units of a library. Each unit contains a function with a different set of call signatures, so that no instantiation is shared among units.
+
+    Args:
+        directory (str): the output directory.
+        library (str): the printing library (ptc / ptc_separate / ptc_erased / fmt / printf).
+        units (int): the number of translation units.
+        calls (int): the number of distinct call signatures per unit.
+        pool (list): the types pool.
+        max_arity (int): the maximum number of arguments of a call.
+
+    Returns:
+        list: the generated source files, main included.
+    """
+
+    # Common header
+    includes = { "ptc": "#include <ptc/print.hpp>\n", "ptc_separate": "#include <ptc/print.hpp>\n", "ptc_erased": "#include <ptc/print.hpp>\n", "fmt": "#include <fmt/core.h>\n#include <fmt/ranges.h>\n", "printf": "#include <cstdio>\n" }
+    header = "#pragma once\n{}#include <map>\n#include <string>\n#include <utility>\n#include <vector>\n\n".format( includes[ library ] )
+    header += "".join( "extern {} {};\n".format( t[ 0 ], variable_name( i ) ) for i, t in enumerate( pool ) )
+    with open( os.path.join( directory, "values.hpp" ), "w" ) as f:
+        f.write( header )
+
+    # Translation units
+    signatures = get_signatures( len( pool ), units * calls, max_arity )
+    sources = []
+    for u in range( units ):
+        body = "\n".join( "  " + call( library, s, pool ) for s in signatures[ u * calls : ( u + 1 ) * calls ] )
+        sources.append( os.path.join( directory, "unit_{}.cpp".format( u ) ) )
+        with open( sources[ -1 ], "w" ) as f:
+            f.write( "#include \"values.hpp\"\n\nvoid unit_{}()\n {{\n{}\n }}\n".format( u, body ) )
+
+    # Main, which runs all the units as many times as its first argument
+    main = "#include \"values.hpp\"\n#include <cstdlib>\n\n"
+    main += "".join( "{} {} = {};\n".format( t[ 0 ], variable_name( i ), t[ 1 ] ) for i, t in enumerate( pool ) )
+    main += "".join( "void unit_{}();\n".format( u ) for u in range( units ) )
+    main += "\nint main( int argc, char** argv )\n {{\n  const long iterations = argc > 1 ? std::atol( argv[ 1 ] ) : 1;\n  for( long i = 0; i < iterations; ++i )\n   {{\n{}\n   }}\n }}\n".format( "\n".join( "    unit_{}();".format( u ) for u in range( units ) ) )
+    sources.append( os.path.join( directory, "main.cpp" ) )
+    with open( sources[ -1 ], "w" ) as f:
+        f.write( main )
+
+    return sources
+
+#################################################
+#     measure
+#################################################
+def measure( command ):
+    """
+    Function used to run a command, measuring its wall time and peak resident set size.
+
+    Args:
+        command (list): the command to run.
+
+    Returns:
+        tuple: the wall time (s) and the peak RSS (KiB).
+
+    Testing:
+        >>> wall, rss = measure( [ "true" ] )
+        >>> wall >= 0 and rss >= 0
+        True
+    """
+
+    start = time.perf_counter()
+    process = subprocess.Popen( command )
+    _, status, usage = os.wait4( process.pid, 0 )
+    wall = time.perf_counter() - start
+    process.returncode = os.waitstatus_to_exitcode( status )
+    if process.returncode != 0:
+        raise RuntimeError( "Command \"{}\" failed!".format( " ".join( command ) ) )
+
+    return wall, usage.ru_maxrss
+
+#################################################
+#     text_size
+#################################################
+def text_size( executable ):
+    """
+    Function used to get the size of the .text section of an executable.
+
+    Args:
+        executable (str): the executable path.
+
+    Returns:
+        int: the .text size (bytes).
+    """
+
+    output = subprocess.run( [ "size", "-A", executable ], capture_output = True, text = True, check = True ).stdout
+    for line in output.splitlines():
+        fields = line.split()
+        if fields and fields[ 0 ] == ".text":
+            return int( fields[ 1 ] )
+
+    return 0
+
+#################################################
+#     parse_perf
+#################################################
+def parse_perf( output ):
+    """
+    Function used to parse the L1 instruction cache misses and the instructions from the CSV output of "perf stat -x,".
+
+    Args:
+        output (str): the perf stat output.
+
+    Returns:
+        tuple: the I-cache misses and the instructions, None if not counted.
+
+    Testing:
+        >>> parse_perf( "1523,,L1-icache-load-misses:u,100.00,,\\n98765,,instructions:u,100.00,,\\n" )
+        (1523, 98765)
+        >>> parse_perf( "<not supported>,,L1-icache-load-misses:u,0,100.00,,\\n98765,,instructions:u,100.00,,\\n" )
+        (None, 98765)
+    """
+
+    counters = {}
+    for line in output.splitlines():
+        fields = line.split( "," )
+        if len( fields ) > 2 and fields[ 0 ].strip().isdigit():
+            counters[ fields[ 2 ].split( ":" )[ 0 ] ] = int( fields[ 0 ] )
+
+    return counters.get( "L1-icache-load-misses" ), counters.get( "instructions" )
+
+#################################################
+#     parse_cachegrind
+#################################################
+def parse_cachegrind( output ):
+    """
+    Function used to parse the L1 instruction cache misses and the instructions from the summary of "valgrind --tool=cachegrind --cache-sim=yes".
+
+    Args:
+        output (str): the cachegrind summary.
+
+    Returns:
+        tuple: the I-cache misses and the instructions, None if not counted.
+
+    Testing:
+        >>> parse_cachegrind( "==1== I   refs:      1,234,567\\n==1== I1  misses:        2,345\\n==1== LLi misses:        1,024\\n" )
+        (2345, 1234567)
+        >>> parse_cachegrind( "" )
+        (None, None)
+    """
+
+    misses = re.search( r"I1\s+misses:\s+([\d,]+)", output )
+    refs = re.search( r"I\s+refs:\s+([\d,]+)", output )
+    to_int = lambda match: int( match.group( 1 ).replace( ",", "" ) ) if match else None
+
+    return to_int( misses ), to_int( refs )
+
+#################################################
+#     icache_misses
+#################################################
+def icache_misses( command ):
+    """
+    Function used to count the L1 instruction cache misses and the instructions of a command, with perf if available or with cachegrind otherwise. The output of the command is discarded.
+
+    Args:
+        command (list): the command to run.
+
+    Returns:
+        tuple: the I-cache misses and the instructions, None if no tool is available.
+    """
+
+    with tempfile.NamedTemporaryFile( mode = "r" ) as log:
+        if shutil.which( "perf" ):
+            tool, parser = [ "perf", "stat", "-x,", "-o", log.name, "-e", "L1-icache-load-misses,instructions" ], parse_perf
+        elif shutil.which( "valgrind" ):
+            tool, parser = [ "valgrind", "--tool=cachegrind", "--cache-sim=yes", "--cachegrind-out-file=/dev/null", "--log-file=" + log.name ], parse_cachegrind
+        else:
+            return None, None
+        subprocess.run( tool + command, stdout = subprocess.DEVNULL, check = True )
+        return parser( log.read() )
+
+#################################################
+#     run
+#################################################
+def run( executable, iterations ):
+    """
+    Function used to measure the runtime of an executable, with its output redirected to /dev/null.
+
+    Args:
+        executable (str): the executable path.
+        iterations (int): the number of times all the print calls are executed.
+
+    Returns:
+        float: the best wall time (s) among three runs.
+    """
+
+    walls = []
+    for _ in range( 3 ):
+        start = time.perf_counter()
+        subprocess.run( [ executable, str( iterations ) ], stdout = subprocess.DEVNULL, check = True )
+        walls.append( time.perf_counter() - start )
+
+    return min( walls )
+
+#################################################
+#     study
+#################################################
+def study( library, pool ):
+    """
+    Function used to generate, compile and link the translation units of a library.
+
+    Args:
+        library (str): the printing library (ptc / ptc_separate / ptc_erased / fmt / printf).
+        pool (list): the types pool.
+
+    Returns:
+        dict: the study results.
+    """
+
+    # Generating sources
+    directory = os.path.join( args.build, library )
+    shutil.rmtree( directory, ignore_errors = True )
+    os.makedirs( directory )
+    sources = generate( directory, library, args.units, args.calls, pool, args.arity )
+
+    # Compiling
+    flags = args.flags.split() + [ "-I" + os.path.abspath( args.include ) ]
+    if args.trace:
+        flags.append( "-ftime-trace" )
+    if library == "ptc_separate":
+        flags.append( "-DPTC_SEPARATE_COMPILATION" )
+        sources.append( os.path.abspath( os.path.join( args.include, "..", "src", "print.cpp" ) ) )
+    elif library == "ptc_erased":
+        flags.append( "-DPTC_TYPE_ERASURE" )
+    objects, walls, rss = [], [], []
+    for source in sources:
+        objects.append( os.path.join( directory, os.path.basename( source ).replace( ".cpp", ".o" ) ) )
+        wall, peak = measure( [ args.compiler, "-c", source, "-o", objects[ -1 ] ] + flags )
+        walls.append( wall )
+        rss.append( peak )
+
+    # Linking
+    executable = os.path.join( directory, library )
+    libraries = [ "-lfmt" ] if library == "fmt" else []
+    link_wall, _ = measure( [ args.compiler ] + objects + [ "-o", executable ] + libraries )
+
+    # Running
+    calls = args.units * args.calls * args.iterations
+    wall = run( executable, args.iterations ) if args.iterations > 0 else None
+    misses, instructions = icache_misses( [ executable, str( args.iterations ) ] ) if args.iterations > 0 else ( None, None )
+
+    return {
+        "library": library,
+        "units": args.units,
+        "calls_per_unit": args.calls,
+        "compile_time": sum( walls ),
+        "compile_time_per_unit": sum( walls[ :args.units ] ) / args.units,
+        "link_time": link_wall,
+        "peak_rss_kib": max( rss ),
+        "text_size": text_size( executable ),
+        "executable_size": os.path.getsize( executable ),
+        "iterations": args.iterations,
+        "run_time": wall,
+        "calls_per_second": calls / wall if wall else None,
+        "icache_misses": misses,
+        "instructions": instructions,
+        "icache_misses_per_call": misses / calls if misses is not None else None
+    }
+
+#################################################
+#     Main
+#################################################
+def main():
+
+    # Choosing the types pool
+    if args.containers == "yes":
+        pool = SCALARS + [ ( t, v, None, None ) for t, v in CONTAINERS ]
+        libraries = [ l for l in args.libraries.split( "," ) if l != "printf" ]
+    else:
+        pool = SCALARS
+        libraries = args.libraries.split( "," )
+
+    # Running the studies
+    results = []
+    for library in libraries:
+        results.append( study( library, pool ) )
+        r = results[ -1 ]
+        print( "{:<12} compile: {:8.2f} s ({:.3f} s/unit)  link: {:6.2f} s  peak RSS: {:8d} KiB  .text: {:9d} B".format(
+            r[ "library" ], r[ "compile_time" ], r[ "compile_time_per_unit" ], r[ "link_time" ], r[ "peak_rss_kib" ], r[ "text_size" ] ), end = "" )
+        if r[ "calls_per_second" ]:
+            print( "  calls/s: {:11.0f}".format( r[ "calls_per_second" ] ), end = "" )
+        if r[ "icache_misses" ] is not None:
+            print( "  I1 misses/call: {:8.3f}".format( r[ "icache_misses_per_call" ] ), end = "" )
+        print()
+
+    # Saving data
+    os.makedirs( os.path.dirname( args.data ) or ".", exist_ok = True )
+    with open( args.data, "w" ) as f:
+        json.dump( { "compiler": args.compiler, "flags": args.flags, "containers": args.containers, "results": results }, f, indent = 2 )
+
+    # Warning about missing counters
+    if args.iterations > 0 and any( r[ "icache_misses" ] is None for r in results ):
+        print( "Warning: I-cache misses have not been counted, since neither perf nor valgrind are available (or the event is not supported)." )
+
+if __name__ == "__main__":
+
+    # Parser settings
+    parser = ap.ArgumentParser( description = "Compile-time and executable size study." )
+    parser.add_argument( "--tests", default = "on", help = "Enable/disable tests (on / off)." )
+    parser.add_argument( "--units", default = 8, type = int, help = "Number of generated translation units." )
+    parser.add_argument( "--calls", default = 32, type = int, help = "Number of distinct call signatures per unit." )
+    parser.add_argument( "--arity", default = 4, type = int, help = "Maximum number of arguments of a call." )
+    parser.add_argument( "--containers", default = "no", help = "Add containers to the printed types, comparing only ptc and fmt (yes / no)." )
+    parser.add_argument( "--libraries", default = "ptc,ptc_separate,ptc_erased,fmt,printf", help = "Comma-separated list of the studied libraries." )
+    parser.add_argument( "--compiler", default = os.environ.get( "CXX", "g++" ), help = "The C++ compiler." )
+    parser.add_argument( "--flags", default = "-std=c++17 -O2", help = "The compilation flags." )
+    parser.add_argument( "--trace", default = "no", help = "Add -ftime-trace to the compilation flags, clang only (yes / no)." )
+    parser.add_argument( "--iterations", default = 1000, type = int, help = "Number of times all the print calls of the executable are run to measure throughput and I-cache misses, 0 to skip the runtime study." )
+    parser.add_argument( "--include", default = "../../include", help = "The ptc-print include directory." )
+    parser.add_argument( "--build", default = "build", help = "The directory of the generated files." )
+    parser.add_argument( "--data", default = "data/compile_time.json", help = "The output dataset." )
+    args = parser.parse_args()
+    args.trace = args.trace == "yes"
+
+    # Main commands
+    if args.tests == "on":
+        if doctest.testmod().failed:
+            sys.exit( 1 )
+        main()
+    elif args.tests == "off":
+        main()
+    else:
+        raise RuntimeError( "Inserted --tests option \"{}\" is not supported!".format( args.tests ) )
@@ -0,0 +1,30 @@
+#!/bin/bash
+
+# $1 = "containers": add containers to the printed types (ptc::print and fmt::print only).
+# Other options are forwarded to compile_time.py, e.g. --units=16 --calls=64.
+
+# Creating directories
+mkdir -p data
+
+# Extra option for containers usage
+mode="scalars"
+containers="no"
+if [ "$1" == "containers" ] ; then
+    mode="containers"
+    containers="yes"
+    shift
+fi
+
+# Enabling time traces with clang
+trace="no"
+if ${CXX:-g++} --version | grep -q clang ; then
+    trace="yes"
+fi
+
+# Generating compile-time data
+./compile_time.py \
+--tests=on \
+--containers=$containers \
+--trace=$trace \
+--data=data/compile_time_$mode.json \
+"$@"
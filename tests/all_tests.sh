@@ -39,6 +39,22 @@ run_all_tests() {
     echo ""
     ./bin/unit_tests
 
+    # Separate compilation tests
+    echo ""
+    echo "======================================================"
+    echo "     SEPARATE COMPILATION TESTS"
+    echo "======================================================"
+    echo ""
+    ./bin/unit_tests_separate
+
+    # Type erasure tests
+    echo ""
+    echo "======================================================"
+    echo "     TYPE ERASURE TESTS"
+    echo "======================================================"
+    echo ""
+    ./bin/unit_tests_erased
+
     # Include tests
     echo ""
     echo "======================================================"
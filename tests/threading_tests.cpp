@@ -4,14 +4,342 @@
 
 // My headers
 #include "../include/ptc/print.hpp"
+#include "../include/ptc/async_print.hpp"
+#include "../include/ptc/binary_log.hpp"
+
+// POSIX-only headers
+#ifndef _WIN32
+ #include "../include/ptc/file_sink.hpp"
+ #include "../include/ptc/mmap_sink.hpp"
+#endif
 
 // STD headers
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 #include <map>
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include <atomic>
+#include <utility>
+
+//====================================================
+//     scaling_benchmark
+//====================================================
+void scaling_benchmark()
+ {
+  // Variables
+  constexpr unsigned lines = 1000;
+  const std::string expected = "Testing 123 print !\n";
+
+  ptc::print( "\nScaling benchmark (", lines, "lines per thread ):" );
+  for ( unsigned n_threads = 1; n_threads <= 32; n_threads *= 2 )
+   {
+    // Each thread writes to its own stream: no contention is expected
+    std::vector <std::ostringstream> private_streams( n_threads );
+    std::vector <std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for ( unsigned i = 0; i < n_threads; ++i )
+     {
+      workers.emplace_back( [ &private_streams, i ]()
+       {
+        for ( unsigned j = 0; j < lines; ++j ) ptc::print( private_streams[ i ], "Testing", 123, "print", '!' );
+       } );
+     }
+    for ( auto& worker: workers ) worker.join();
+    const std::chrono::duration <double, std::milli> private_time = std::chrono::steady_clock::now() - start;
+
+    // All threads write to the same stream: each line must stay atomic
+    std::ostringstream shared_stream;
+    workers.clear();
+    start = std::chrono::steady_clock::now();
+    for ( unsigned i = 0; i < n_threads; ++i )
+     {
+      workers.emplace_back( [ &shared_stream ]()
+       {
+        for ( unsigned j = 0; j < lines; ++j ) ptc::print( shared_stream, "Testing", 123, "print", '!' );
+       } );
+     }
+    for ( auto& worker: workers ) worker.join();
+    const std::chrono::duration <double, std::milli> shared_time = std::chrono::steady_clock::now() - start;
+
+    // Checking output
+    for ( const auto& stream: private_streams )
+     {
+      if ( stream.str().size() != lines * expected.size() ) throw std::runtime_error( "Wrong output size in private stream!" );
+     }
+    std::istringstream shared_lines( shared_stream.str() );
+    std::string line;
+    unsigned counter = 0;
+    while ( std::getline( shared_lines, line ) )
+     {
+      if ( line + "\n" != expected ) throw std::runtime_error( "Interleaved output in shared stream!" );
+      ++counter;
+     }
+    if ( counter != n_threads * lines ) throw std::runtime_error( "Wrong number of lines in shared stream!" );
+
+    ptc::print( "  threads:", n_threads, "| private streams:", private_time.count(), "ms | shared stream:", shared_time.count(), "ms" );
+   }
+ }
+
+//====================================================
+//     async_jobs
+//====================================================
+void async_jobs()
+ {
+  // Variables
+  constexpr unsigned lines = 1000, n_threads = 4;
+  std::ostringstream strout;
+  std::vector <std::thread> workers;
+
+  // Concurrent producers
+   {
+    ptc::AsyncPrint async_print( strout, 64 );
+    for ( unsigned i = 0; i < n_threads; ++i )
+     {
+      workers.emplace_back( [ &async_print ]()
+       {
+        for ( unsigned j = 0; j < lines; ++j ) async_print( "Testing", 123, "print", '!' );
+        async_print.flush();
+       } );
+     }
+    for ( auto& worker: workers ) worker.join();
+   }
+
+  // Checking output
+  std::istringstream async_lines( strout.str() );
+  std::string line;
+  unsigned counter = 0;
+  while ( std::getline( async_lines, line ) )
+   {
+    if ( line != "Testing 123 print !" ) throw std::runtime_error( "Interleaved output in asynchronous print!" );
+    ++counter;
+   }
+  if ( counter != n_threads * lines ) throw std::runtime_error( "Lost messages in asynchronous print!" );
+ }
+
+#ifndef _WIN32
+
+//====================================================
+//     file_sink_jobs
+//====================================================
+void file_sink_jobs()
+ {
+  // Variables
+  constexpr unsigned lines = 1000, n_threads = 4;
+  std::vector <std::thread> workers;
+  std::remove( "test_sink.txt" );
+
+  // Concurrent writers, with and without batching
+  for ( std::size_t buffer_size: { std::size_t( 0 ), std::size_t( 4096 ) } )
+   {
+    ptc::FileSink sink( "test_sink.txt", buffer_size );
+    for ( unsigned i = 0; i < n_threads; ++i )
+     {
+      workers.emplace_back( [ &sink ]()
+       {
+        for ( unsigned j = 0; j < lines; ++j ) ptc::print( sink, "Testing", 123, "print", '!' );
+       } );
+     }
+    for ( auto& worker: workers ) worker.join();
+    workers.clear();
+   }
+
+  // Checking output
+  std::ifstream file( "test_sink.txt" );
+  std::string line;
+  unsigned counter = 0;
+  while ( std::getline( file, line ) )
+   {
+    if ( line != "Testing 123 print !" ) throw std::runtime_error( "Interleaved output in file sink!" );
+    ++counter;
+   }
+  if ( counter != 2 * n_threads * lines ) throw std::runtime_error( "Lost lines in file sink!" );
+  std::remove( "test_sink.txt" );
+ }
+
+//====================================================
+//     mmap_sink_jobs
+//====================================================
+void mmap_sink_jobs()
+ {
+  // Variables
+  constexpr unsigned lines = 10000, n_threads = 4;
+  std::vector <std::thread> workers;
+
+  // Concurrent writers, with size and time rotation
+   {
+    ptc::MmapSink sink( "test_mmap.log", 16384, std::chrono::milliseconds( 1 ) );
+    for ( unsigned i = 0; i < n_threads; ++i )
+     {
+      workers.emplace_back( [ &sink ]()
+       {
+        for ( unsigned j = 0; j < lines; ++j ) ptc::print( sink, "Testing", 123, "print", '!' );
+       } );
+     }
+    for ( auto& worker: workers ) worker.join();
+   }
+
+  // Checking output
+  unsigned counter = 0;
+  for ( unsigned i = 0; ; ++i )
+   {
+    const std::string path = "test_mmap.log." + std::to_string( i );
+    std::ifstream segment( path );
+    if ( ! segment ) break;
+    std::string line;
+    while ( std::getline( segment, line ) )
+     {
+      if ( line != "Testing 123 print !" ) throw std::runtime_error( "Interleaved output in mmap sink!" );
+      ++counter;
+     }
+    segment.close();
+    std::remove( path.c_str() );
+   }
+  if ( counter != n_threads * lines ) throw std::runtime_error( "Lost lines in mmap sink!" );
+ }
+
+#endif
+
+//====================================================
+//     binary_log_jobs
+//====================================================
+void binary_log_jobs()
+ {
+  // Variables
+  constexpr unsigned lines = 10000, n_threads = 4;
+  std::vector <std::thread> workers;
+  std::remove( "test_log.bin" );
+
+  // Concurrent writers, with small staging buffers
+   {
+    ptc::BinaryLog log( "test_log.bin", ptc::print, 4096 );
+    for ( unsigned i = 0; i < n_threads; ++i )
+     {
+      workers.emplace_back( [ &log ]()
+       {
+        for ( unsigned j = 0; j < lines; ++j ) log( "Testing", 123, "print", '!' );
+       } );
+     }
+    for ( auto& worker: workers ) worker.join();
+   }
+
+  // Checking output
+  std::ifstream log_file( "test_log.bin", std::ios::binary );
+  std::stringstream content;
+  if ( ! ptc::decode_log( log_file, content ) ) throw std::runtime_error( "Invalid binary log!" );
+  log_file.close();
+  std::remove( "test_log.bin" );
+  unsigned counter = 0;
+  std::string line;
+  while ( std::getline( content, line ) )
+   {
+    if ( line != "Testing 123 print !" ) throw std::runtime_error( "Corrupted record in binary log!" );
+    ++counter;
+   }
+  if ( counter != n_threads * lines ) throw std::runtime_error( "Lost records in binary log!" );
+ }
+
+//====================================================
+//     log_sequence
+//====================================================
+template <class T, std::size_t... I>
+void log_sequence( ptc::BinaryLog& log, std::index_sequence <I...> )
+ {
+  log( static_cast <T> ( I )... );
+ }
+
+//====================================================
+//     binary_log_signatures
+//====================================================
+template <std::size_t... N>
+void binary_log_signatures( std::index_sequence <N...> )
+ {
+  // Variables
+  std::atomic <bool> done{ false };
+  std::remove( "test_log.bin" );
+
+  // A thread registers new signatures while another one drains the log
+   {
+    ptc::BinaryLog log( "test_log.bin", ptc::print );
+    std::thread drainer( [ &log, &done ]()
+     {
+      while ( ! done.load() ) log.flush();
+     } );
+    ( log_sequence <short>( log, std::make_index_sequence <N + 1>{} ), ... );
+    ( log_sequence <unsigned short>( log, std::make_index_sequence <N + 1>{} ), ... );
+    done.store( true );
+    drainer.join();
+   }
+
+  // Checking output: each record must follow its signature
+  std::ifstream log_file( "test_log.bin", std::ios::binary );
+  std::stringstream content;
+  if ( ! ptc::decode_log( log_file, content ) ) throw std::runtime_error( "Binary log record written before its signature!" );
+  log_file.close();
+  std::remove( "test_log.bin" );
+  unsigned counter = 0;
+  std::string line;
+  while ( std::getline( content, line ) ) ++counter;
+  if ( counter != 2 * sizeof...( N ) ) throw std::runtime_error( "Lost records in binary log!" );
+ }
+
+//====================================================
+//     settings_jobs
+//====================================================
+void settings_jobs()
+ {
+  // Variables
+  constexpr unsigned lines = 10000, n_threads = 4;
+  ptc::Print printer;
+  std::vector <std::ostringstream> streams( n_threads );
+  std::vector <std::thread> workers;
+  std::atomic <bool> done{ false };
+
+  // A writer switches between two configurations while the other threads are printing
+  std::thread writer( [ &printer, &done ]()
+   {
+    for ( unsigned i = 0; ! done; ++i )
+     {
+      printer.setSep( i % 2 ? "*" : "-" );
+      printer.setEnd( i % 2 ? "*\n" : "-\n" );
+     }
+   } );
+  for ( unsigned i = 0; i < n_threads; ++i )
+   {
+    workers.emplace_back( [ &printer, &streams, i ]()
+     {
+      for ( unsigned j = 0; j < lines; ++j ) 
+       {
+        printer( streams[ i ], "a", "b", "c" );
+        printer.getSep();
+       }
+     } );
+   }
+  for ( auto& worker: workers ) worker.join();
+  done = true;
+  writer.join();
+
+  // Checking output: the separators of each line must come from a single configuration
+  for ( auto& stream: streams )
+   {
+    std::istringstream content( stream.str() );
+    std::string line;
+    unsigned counter = 0;
+    while ( std::getline( content, line ) )
+     {
+      const bool default_line = line == "a b c";
+      const bool valid_line = line.size() == 6 && line[ 1 ] == line[ 3 ] && line[ 1 ] != ' ';
+      if ( ! default_line && ! valid_line ) throw std::runtime_error( "Inconsistent configuration in print call!" );
+      ++counter;
+     }
+    if ( counter != lines ) throw std::runtime_error( "Lost lines in print calls!" );
+   }
+ }
 
 //====================================================
 //     main
@@ -101,4 +429,21 @@ int main()
   second_job.join();
 
   file_stream.close();
+
+  // Asynchronous print
+  async_jobs();
+
+  // File sinks
+  #ifndef _WIN32
+   file_sink_jobs();
+   mmap_sink_jobs();
+  #endif
+  binary_log_jobs();
+  binary_log_signatures( std::make_index_sequence <32>{} );
+
+  // Configuration updates
+  settings_jobs();
+
+  // Scaling benchmark
+  scaling_benchmark();
  }
\ No newline at end of file
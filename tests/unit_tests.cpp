@@ -10,17 +10,40 @@
 
 // My headers
 #include "../include/ptc/print.hpp"
+#include "../include/ptc/async_print.hpp"
+#include "../include/ptc/parallel_print.hpp"
+#include "../include/ptc/buffered_print.hpp"
+#include "../include/ptc/static_print.hpp"
+#include "../include/ptc/binary_log.hpp"
+#include "../include/ptc/basic_print.hpp"
+#include "../include/ptc/fixed_print.hpp"
 #include "utils.hpp"
 
+// POSIX-only headers
+#ifndef _WIN32
+ #include "../include/ptc/file_sink.hpp"
+ #include "../include/ptc/mmap_sink.hpp"
+#endif
+
 // Extra headers
 #include <doctest/doctest.h>
 
 // STD headers
 #include <iostream>
+#include <algorithm>
 #include <sstream>
+#include <iomanip>
 #include <fstream>
 #include <string>
+#include <cstdio>
 #include <complex>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <locale>
 
 // Containers for testing
 #include <vector>
@@ -35,6 +58,122 @@
 #include <stack>
 #include <queue>
 
+//====================================================
+//     Allocation guard
+//====================================================
+
+// allocation_guard
+/**
+ * @brief Struct used to make the global operator new fail in the current thread, while it is alive.
+ * 
+ */
+struct allocation_guard
+ {
+  allocation_guard() { armed() = true; failures() = 0; }
+  ~allocation_guard() { armed() = false; }
+
+  static bool& armed() { thread_local bool value = false; return value; }
+  static std::size_t& failures() { thread_local std::size_t value = 0; return value; }
+ };
+
+void* operator new( std::size_t size )
+ {
+  if ( allocation_guard::armed() )
+   {
+    ++allocation_guard::failures();
+    throw std::bad_alloc();
+   }
+  if ( void* ptr = std::malloc( size ? size : 1 ) ) return ptr;
+  throw std::bad_alloc();
+ }
+
+void operator delete( void* ptr ) noexcept { std::free( ptr ); }
+void operator delete( void* ptr, std::size_t ) noexcept { std::free( ptr ); }
+
+//====================================================
+//     Helper types
+//====================================================
+
+// nested_print
+struct nested_print {};
+
+std::ostream& operator <<( std::ostream& os, const nested_print& )
+ {
+  ptc::print.setEnd( "" );
+  os << ptc::print( ptc::mode::str, "nested", "call" );
+  ptc::print.setEnd( "\n" );
+  return os;
+ }
+
+// gate_buf
+class gate_buf: public std::stringbuf
+ {
+  public:
+   void wait_entered()
+    {
+     std::unique_lock <std::mutex> lock{ mutex_ };
+     cv_.wait( lock, [ this ]{ return entered_; } );
+    }
+
+   void release()
+    {
+     std::lock_guard <std::mutex> lock{ mutex_ };
+     open_ = true;
+     cv_.notify_all();
+    }
+
+  protected:
+   std::streamsize xsputn( const char* s, std::streamsize n ) override
+    {
+     std::unique_lock <std::mutex> lock{ mutex_ };
+     entered_ = true;
+     cv_.notify_all();
+     cv_.wait( lock, [ this ]{ return open_; } );
+     return std::stringbuf::xsputn( s, n );
+    }
+
+  private:
+   std::mutex mutex_;
+   std::condition_variable cv_;
+   bool entered_ = false, open_ = false;
+ };
+
+// chunk_sink
+struct chunk_sink
+ {
+  void write( std::string_view line, bool )
+   {
+    content.append( line.data(), line.size() );
+    chunks.push_back( line.size() );
+   }
+
+  std::string content;
+  std::vector <std::size_t> chunks;
+ };
+
+// fixed_sink
+struct fixed_sink
+ {
+  void write( std::string_view line, bool )
+   {
+    const std::size_t n = std::min( line.size(), sizeof( content ) - size );
+    std::copy_n( line.data(), n, content + size );
+    size += n;
+   }
+
+  char content[ 64 ] = {};
+  std::size_t size = 0;
+ };
+
+namespace ptc
+ {
+  template <>
+  struct is_sink <chunk_sink>: std::true_type {};
+
+  template <>
+  struct is_sink <fixed_sink>: std::true_type {};
+ }
+
 //====================================================
 //     Print default constructor
 //====================================================
@@ -116,9 +255,85 @@ TEST_CASE( "Testing the operator () overload." )
     file_stream_i.read( str, 26 );
     file_stream_i.close();
 
-    CHECK_EQ( static_cast<std::string> ( str ), "Test passes (ignore this)." );
+    CHECK_EQ( std::string( str, 26 ), "Test passes (ignore this)." );
+   }
+
+  #ifndef _WIN32
+
+  // ptc::FileSink case
+  SUBCASE( "ptc::FileSink case." )
+   {
+    std::remove( "test_sink.txt" );
+     {
+      ptc::FileSink sink( "test_sink.txt" );
+      ptc::print( sink, "Test", "passes (ignore this)." );
+      ptc::print( sink );
+     }
+     {
+      ptc::FileSink sink( "test_sink.txt", 1024, ptc::sync_policy::on_flush );
+      ptc::print( sink, "Batched", 1 );
+      ptc::print( sink, "Batched", 2, ptc::flush );
+      ptc::print( sink, "Batched", 3 );
+      CHECK_EQ( sink.getError().value(), 0 );
+     }
+
+    std::ifstream file_stream_i( "test_sink.txt" );
+    std::stringstream content;
+    content << file_stream_i.rdbuf();
+    CHECK_EQ( content.str(), "Test passes (ignore this).\n\nBatched 1\nBatched 2\nBatched 3\n" );
+    std::remove( "test_sink.txt" );
+
+    CHECK_THROWS_AS( ptc::FileSink( "missing_directory/test_sink.txt" ), std::system_error );
+   }
+
+  // ptc::MmapSink case
+  SUBCASE( "ptc::MmapSink case." )
+   {
+    std::string expected;
+     {
+      ptc::MmapSink sink( "test_mmap.log", 4096 );
+      for ( int i = 0; i < 1000; ++i ) 
+       {
+        ptc::print( sink, "Line", i );
+        expected += "Line " + std::to_string( i ) + "\n";
+       }
+      ptc::print( sink, std::string( 5000, 'x' ) );
+      expected += std::string( 5000, 'x' ) + "\n";
+      CHECK_EQ( sink.getDropped(), 0 );
+     }
+
+    // Reading the segments in order
+    std::string content;
+    for ( int i = 0; ; ++i )
+     {
+      std::ifstream segment( "test_mmap.log." + std::to_string( i ) );
+      if ( ! segment ) break;
+      std::stringstream segment_content;
+      segment_content << segment.rdbuf();
+      content += segment_content.str();
+      std::remove( ( "test_mmap.log." + std::to_string( i ) ).c_str() );
+     }
+    CHECK_EQ( content, expected );
+
+    // Restarting a sink does not overwrite the existing segments
+    for ( int run = 0; run < 2; ++run )
+     {
+      ptc::MmapSink sink( "test_mmap.log", 4096 );
+      ptc::print( sink, "Run", run );
+     }
+    for ( int run = 0; run < 2; ++run )
+     {
+      std::ifstream segment( "test_mmap.log." + std::to_string( run ) );
+      std::stringstream segment_content;
+      segment_content << segment.rdbuf();
+      CHECK_EQ( segment_content.str(), "Run " + std::to_string( run ) + "\n" );
+      segment.close();
+      std::remove( ( "test_mmap.log." + std::to_string( run ) ).c_str() );
+     }
    }
 
+  #endif
+
   // std::fstream case
   SUBCASE( "std::fstream case." )
    {
@@ -133,7 +348,7 @@ TEST_CASE( "Testing the operator () overload." )
     file_stream_i.read( str, 26 );
     file_stream_i.close();
 
-    CHECK_EQ( static_cast<std::string> ( str ), "Test passes (ignore this)." );
+    CHECK_EQ( std::string( str, 26 ), "Test passes (ignore this)." );
    }
 
   // Passing variables inside ptc::print
@@ -159,6 +374,99 @@ TEST_CASE( "Testing the operator () overload." )
     ptc::print.setEnd( "\n" );
    }
 
+  // Output targets
+  SUBCASE( "Output targets." )
+   {
+    ptc::print.setEnd( "" );
+
+    // std::string
+    std::string str = "Old content";
+    str.reserve( 64 );
+    const char* storage = str.data();
+    CHECK_EQ( ptc::print( ptc::to( str ), "Key", 1 ), 5 );
+    CHECK_EQ( str, "Key 1" );
+    CHECK_EQ( str.data(), storage );
+    CHECK_EQ( ptc::print( ptc::to( str ) ), 0 );
+    CHECK_EQ( str, "" );
+
+    // Bounded buffer
+    char buf[ 8 ] = {};
+    const auto result = ptc::print( ptc::to( buf, sizeof( buf ) ), "Truncated", "key" );
+    CHECK_EQ( result.size, 13 );
+    CHECK_EQ( result.out, buf + 8 );
+    CHECK_EQ( std::string( buf, 8 ), "Truncate" );
+    const auto result_2 = ptc::print( ptc::to( buf, sizeof( buf ) ), "Key", 2 );
+    CHECK_EQ( result_2.size, 5 );
+    CHECK_EQ( std::string( buf, result_2.out ), "Key 2" );
+
+    // Output iterator
+    std::vector <char> vec;
+    ptc::print( ptc::to( std::back_inserter( vec ) ), "Key", 3 );
+    CHECK_EQ( std::string( vec.begin(), vec.end() ), "Key 3" );
+
+    // Memory resource, without other allocations after the first call
+    #ifdef PTC_MEMORY_RESOURCE
+    char storage_arena[ 1024 ];
+    std::pmr::monotonic_buffer_resource arena( storage_arena, sizeof( storage_arena ), std::pmr::null_memory_resource() );
+    const std::string payload( 100, 'x' );
+    std::pmr::string pmr_str = ptc::print( ptc::str_in( arena ), "Key", 4, payload );
+    CHECK_EQ( pmr_str.get_allocator().resource(), &arena );
+    CHECK( std::string_view( pmr_str ) == "Key 4 " + payload );
+     {
+      allocation_guard guard;
+      try
+       {
+        pmr_str = ptc::print( ptc::str_in( arena ), "Key", 5, payload );
+       }
+      catch( const std::bad_alloc& ) {}
+      CHECK_EQ( allocation_guard::failures(), 0 );
+     }
+    CHECK( std::string_view( pmr_str ) == "Key 5 " + payload );
+    CHECK( ptc::print( ptc::str_in( arena ) ).empty() );
+    #endif
+
+    ptc::print.setEnd( "\n" );
+   }
+
+  // Call options
+  SUBCASE( "Call options." )
+   {
+    CHECK_EQ( ptc::print( ptc::mode::str, "a", "b", ptc::sep( "*" ), ptc::end( "!" ) ), "a*b!" );
+    CHECK_EQ( ptc::print( ptc::mode::str, ptc::end( "" ), "a", 1, 2.5 ), "a 1 2.5" );
+    CHECK_EQ( ptc::print( ptc::mode::str, "\033[31m", "Red", ptc::end( "" ) ), "\033[31mRed \033[0m" );
+    CHECK_EQ( ptc::print( ptc::mode::str, ptc::end( "." ) ), "." );
+    CHECK_EQ( ptc::print.getSep(), " " );
+    CHECK_EQ( ptc::print.getEnd(), "\n" );
+
+    std::ostringstream ostr;
+    ptc::print( ostr, "x", "y", ptc::sep( ", " ), ptc::flush );
+    CHECK_EQ( ostr.str(), "x, y\n" );
+
+    std::string str;
+    CHECK_EQ( ptc::print( ptc::to( str ), 1, 2, ptc::sep( "" ), ptc::end( "" ) ), 2 );
+    CHECK_EQ( str, "12" );
+
+    ptc::StaticPrint <> static_print;
+    CHECK_EQ( static_print( ptc::mode::str, 1, 2, ptc::sep( "-" ) ), "1-2\n" );
+   }
+
+  // Testing the formatting state of the target stream
+  SUBCASE( "Testing the formatting state of the target stream." )
+   {
+    std::ostringstream ostr;
+    ostr.precision( 3 );
+    ptc::print( ostr, 3.14159, 2.71828 );
+    CHECK_EQ( ostr.str(), "3.14 2.72\n" );
+   }
+
+  // Testing nested print calls
+  SUBCASE( "Testing nested print calls." )
+   {
+    std::ostringstream ostr;
+    ptc::print( ostr, "Outer", nested_print{}, "call" );
+    CHECK_EQ( ostr.str(), "Outer nested call call\n" );
+   }
+
   // Testing usage of ANSI escape sequence and final reset
   SUBCASE( "Testing usage of ANSI escape sequence and final reset." )
    {
@@ -169,13 +477,33 @@ TEST_CASE( "Testing the operator () overload." )
     const std::string test_b = ptc::print( ptc::mode::str, "Testing", "\033[31mcolors", "(ignore this)." );
     CHECK_EQ( test_b, "Testing \033[31mcolors (ignore this).\033[0m" );
     const std::string test_c = ptc::print( ptc::mode::str, "Testing", "the \033[31mcolors", "(ignore this)." );
-    CHECK_EQ( test_c, "Testing the \033[31mcolors (ignore this).\033[0m" );
+    CHECK_EQ( test_c, "Testing the \033[31mcolors (ignore this)." );
+    ptc::print.setEscapeScan( true );
+    CHECK_EQ( ptc::print.getEscapeScan(), true );
+    const std::string test_d = ptc::print( ptc::mode::str, "Testing", "the \033[31mcolors", "(ignore this)." );
+    CHECK_EQ( test_d, "Testing the \033[31mcolors (ignore this).\033[0m" );
+    const std::string long_str = std::string( 100, 'x' ) + "\033[31m" + std::string( 5, 'x' );
+    CHECK_EQ( ptc::print( ptc::mode::str, long_str ), long_str + "\033[0m" );
+    CHECK_EQ( ptc::print( ptc::mode::str, std::string( 100, 'x' ) ), std::string( 100, 'x' ) );
+    ptc::print.setEscapeScan( false );
     CHECK_EQ( ptc::print( ptc::mode::str, 1, "Number" ), "1 Number" );
     const std::string test_nullptr = ptc::print( ptc::mode::str, "Hey", nullptr, nullptr );
     CHECK_EQ( test_nullptr, "Hey nullptr nullptr" );
     ptc::print.setEnd( "\n" );
    }
 
+  // Testing usage of ANSI styles
+  SUBCASE( "Testing usage of ANSI styles." )
+   {
+    ptc::print.setEnd( "" );
+    CHECK_EQ( ptc::print( ptc::mode::str, ptc::style::red, "Error" ), "\033[31mError \033[0m" );
+    CHECK_EQ( ptc::print( ptc::mode::str, "Testing", ptc::style::bold, "bold" ), "Testing \033[1m bold\033[0m" );
+    std::ostringstream ostr;
+    ostr << ptc::style::green;
+    CHECK_EQ( ostr.str(), "\033[32m" );
+    ptc::print.setEnd( "\n" );
+   }
+
   // Testing usage of ANSI or empty character as first argument
   SUBCASE( "Testing ANSI escape sequence or empty character as first argument." )
    {
@@ -216,8 +544,8 @@ TEST_CASE( "Testing the Print operator << overloads." )
     ptc::print.setEnd( "" );
 
     // std::array
-    //std::array <int, 3> array = { 1, 2, 3 };
-    //CHECK_EQ( ptc::print( ptc::mode::str, array ), "[1, 2, 3]" );
+    std::array <int, 3> array = { 1, 2, 3 };
+    CHECK_EQ( ptc::print( ptc::mode::str, array ), "[1, 2, 3]" );
 
     // std::vector
     std::vector <int> vec = { 1, 2, 3 };
@@ -362,4 +690,609 @@ TEST_CASE( "Testing the Print setFlush and getFlush methods." )
   CHECK( sbuf.str() != "Test thisssa.\n" );
 
   ptc::print.setFlush( false );
- }
\ No newline at end of file
+ }
+
+//====================================================
+//     Print setFastFormatting and getFastFormatting
+//====================================================
+TEST_CASE( "Testing the Print fast formatting." )
+ {
+  ptc::print.setEnd( "" );
+  CHECK_EQ( ptc::print.getFastFormatting(), true );
+
+  // Arithmetic types
+  SUBCASE( "Arithmetic types." )
+   {
+    CHECK_EQ( ptc::print( ptc::mode::str, 0.1 + 0.2 ), "0.30000000000000004" );
+    CHECK_EQ( ptc::print( ptc::mode::str, 1.0, 2.5f, -3e20 ), "1 2.5 -3e+20" );
+    CHECK_EQ( ptc::print( ptc::mode::str, -42, 18446744073709551615ull, 'c', true ), "-42 18446744073709551615 c 1" );
+    CHECK_EQ( ptc::print( ptc::mode::str, std::complex <double>( 1.5, -2 ) ), "1.5+-2j" );
+   }
+
+  // Manipulators of the target stream
+  SUBCASE( "Manipulators of the target stream." )
+   {
+    std::ostringstream ostr;
+    ostr << std::hex;
+    ptc::print( ostr, 255, 16 );
+    CHECK_EQ( ostr.str(), "ff 10" );
+
+    std::ostringstream ostr_hex;
+    ostr_hex << std::hex;
+    ptc::print( ostr_hex, static_cast <short> ( -1 ), -1, -1ll, 2.5f, 2.5l );
+    CHECK_EQ( ostr_hex.str(), "ffff ffffffff ffffffffffffffff 2.5 2.5" );
+
+    std::ostringstream ostr_2;
+    ostr_2 << std::fixed << std::setprecision( 2 );
+    ptc::print( ostr_2, 0.1 + 0.2 );
+    CHECK_EQ( ostr_2.str(), "0.30" );
+   }
+
+  // Locale of the target stream
+  SUBCASE( "Locale of the target stream." )
+   {
+    struct grouping_punct: std::numpunct <char>
+     {
+      char do_decimal_point() const override { return ';'; }
+      char do_thousands_sep() const override { return ','; }
+      std::string do_grouping() const override { return "\3"; }
+     };
+    std::ostringstream ostr;
+    ostr.imbue( std::locale( std::locale::classic(), new grouping_punct ) );
+    ptc::print( ostr, 1234567, 2.5 );
+    CHECK_EQ( ostr.str(), "1,234,567 2;5" );
+
+    std::ostringstream ostr_classic;
+    ptc::print( ostr_classic, 1234567, 2.5 );
+    CHECK_EQ( ostr_classic.str(), "1234567 2.5" );
+
+    const std::locale global = std::locale::global( std::locale( std::locale::classic(), new grouping_punct ) );
+    CHECK_EQ( ptc::print( ptc::mode::str, 1234567, 2.5 ), "1,234,567 2;5" );
+    std::locale::global( global );
+    CHECK_EQ( ptc::print( ptc::mode::str, 1234567, 2.5 ), "1234567 2.5" );
+   }
+
+  // Compatibility mode
+  SUBCASE( "Compatibility mode." )
+   {
+    ptc::print.setFastFormatting( false );
+    CHECK_EQ( ptc::print.getFastFormatting(), false );
+    CHECK_EQ( ptc::print( ptc::mode::str, 0.1 + 0.2, 1e20 ), "0.3 1e+20" );
+    ptc::print.setFastFormatting( true );
+   }
+
+  ptc::print.setEnd( "\n" );
+ }
+
+//====================================================
+//     Print container truncation and chunking
+//====================================================
+TEST_CASE( "Testing the Print container truncation and chunking." )
+ {
+  // Truncation
+  SUBCASE( "Truncation." )
+   {
+    const std::vector <std::vector <int>> vec = { { 1, 2, 3, 4 }, { 5 }, {}, { 6 } };
+    ptc::print.setMaxItems( 3 );
+    CHECK_EQ( ptc::print.getMaxItems(), 3 );
+    CHECK_EQ( ptc::print( ptc::mode::str, vec ), "[[1, 2, 3, ...], [5], [], ...]\n" );
+    ptc::print.setMaxItems( 0 );
+    ptc::print.setMaxDepth( 1 );
+    CHECK_EQ( ptc::print.getMaxDepth(), 1 );
+    CHECK_EQ( ptc::print( ptc::mode::str, vec ), "[[...], [...], [], [...]]\n" );
+    ptc::print.setFastFormatting( false );
+    CHECK_EQ( ptc::print( ptc::mode::str, vec ), "[[...], [...], [], [...]]\n" );
+    ptc::print.setFastFormatting( true );
+    ptc::print.setMaxDepth( 0 );
+    CHECK_EQ( ptc::print( ptc::mode::str, vec ), "[[1, 2, 3, 4], [5], [], [6]]\n" );
+   }
+
+  // Chunking
+  SUBCASE( "Chunking." )
+   {
+    std::vector <int> vec( 100000 );
+    for ( std::size_t i = 0; i < vec.size(); ++i ) vec[ i ] = static_cast <int> ( i );
+    const std::string expected = ptc::print( ptc::mode::str, "Big", vec );
+
+    std::ostringstream ostr;
+    ptc::print( ostr, "Big", vec );
+    CHECK_EQ( ostr.str(), expected );
+
+    chunk_sink sink;
+    ptc::print( sink, "Big", vec );
+    CHECK_EQ( sink.content, expected );
+    CHECK( sink.chunks.size() > 1 );
+    CHECK( *std::max_element( sink.chunks.begin(), sink.chunks.end() ) < ( 1 << 17 ) );
+   }
+
+  // Parallel formatting
+  SUBCASE( "Parallel formatting." )
+   {
+    std::vector <int> vec( 300000 );
+    std::deque <std::string> deq( 100000, "str" );
+    std::vector <std::vector <double>> nested( 70000, { 0.5, -1.0 } );
+    for ( std::size_t i = 0; i < vec.size(); ++i ) vec[ i ] = static_cast <int> ( i * 7919 );
+    const std::string expected = ptc::print( ptc::mode::str, vec, deq, nested );
+
+    ptc::print.setParallel( 4 );
+    CHECK_EQ( ptc::print.getParallel(), 4 );
+    CHECK_EQ( ptc::print( ptc::mode::str, vec, deq, nested ), expected );
+    chunk_sink sink;
+    ptc::print( sink, vec, deq, nested );
+    CHECK_EQ( sink.content, expected );
+    ptc::print.setMaxItems( 100000 );
+    CHECK_EQ( ptc::print( ptc::mode::str, vec ), expected.substr( 0, expected.find( ", " + std::to_string( vec[ 100000 ] ) + "," ) ) + ", ...]\n" );
+    ptc::print.setMaxItems( 0 );
+    ptc::print.setParallel( 1 );
+   }
+ }
+
+//====================================================
+//     Print numeric ranges
+//====================================================
+TEST_CASE( "Testing the Print numeric ranges." )
+ {
+  ptc::print.setEnd( "" );
+
+  // Integers
+  SUBCASE( "Integers." )
+   {
+    const std::vector <long long> vec = { 0, 7, -7, 12345678, 123456789, -9223372036854775807LL - 1, 9223372036854775807LL, 10000000000000000LL };
+    CHECK_EQ( ptc::print( ptc::mode::str, vec ), "[0, 7, -7, 12345678, 123456789, -9223372036854775808, 9223372036854775807, 10000000000000000]" );
+    const std::array <unsigned long long, 2> array = { 18446744073709551615ull, 99999999ull };
+    CHECK_EQ( ptc::print( ptc::mode::str, array ), "[18446744073709551615, 99999999]" );
+    const short arr[ 3 ] = { -32768, 0, 32767 };
+    CHECK_EQ( ptc::print( ptc::mode::str, arr ), "[-32768, 0, 32767]" );
+   }
+
+  // Floating-point numbers
+  SUBCASE( "Floating-point numbers." )
+   {
+    const std::array <double, 3> array = { 0.1, -2.5, 1e100 };
+    CHECK_EQ( ptc::print( ptc::mode::str, array ), "[0.1, -2.5, 1e+100]" );
+    std::ostringstream ostr;
+    ostr << std::fixed << std::setprecision( 1 );
+    ptc::print( ostr, array );
+    CHECK_EQ( ostr.str(), "[0.1, -2.5, 10000000000000000159028911097599180468360808563945281389781327557747838772170381060813469985856815104.0]" );
+   }
+
+  // Span-like types and truncation
+  SUBCASE( "Span-like types and truncation." )
+   {
+    struct int_span
+     {
+      const int* data() const { return values; }
+      std::size_t size() const { return 4; }
+      const int* begin() const { return values; }
+      const int* end() const { return values + 4; }
+      int values[ 4 ] = { 1, 2, 3, 4 };
+     };
+    CHECK_EQ( ptc::print( ptc::mode::str, int_span{} ), "[1, 2, 3, 4]" );
+    ptc::print.setMaxItems( 2 );
+    CHECK_EQ( ptc::print( ptc::mode::str, int_span{} ), "[1, 2, ...]" );
+    ptc::print.setMaxItems( 0 );
+    ptc::print.setMaxDepth( 1 );
+    CHECK_EQ( ptc::print( ptc::mode::str, std::vector <std::vector <int>>{ { 1 } } ), "[[...]]" );
+    ptc::print.setMaxDepth( 0 );
+   }
+
+  ptc::print.setEnd( "\n" );
+ }
+
+//====================================================
+//     StaticPrint class
+//====================================================
+TEST_CASE( "Testing the StaticPrint class." )
+ {
+  ptc::StaticPrint <ptc::chars<',', ' '>, ptc::chars<'.', '\n'>> csv_print;
+  CHECK_EQ( csv_print.getSep(), ", " );
+  CHECK_EQ( csv_print.getEnd(), ".\n" );
+  CHECK_EQ( csv_print.getFlush(), false );
+
+  // Stream and string cases
+  std::ostringstream ostr;
+  csv_print( ostr, "Test", 1, 2.5 );
+  csv_print( ostr );
+  CHECK_EQ( ostr.str(), "Test, 1, 2.5.\n.\n" );
+  CHECK_EQ( csv_print( ptc::mode::str, "a", 'b' ), "a, b.\n" );
+  std::string str;
+  CHECK_EQ( csv_print( ptc::to( str ), "a", 'b' ), 6 );
+  CHECK_EQ( str, "a, b.\n" );
+  #ifdef PTC_MEMORY_RESOURCE
+  std::pmr::monotonic_buffer_resource arena;
+  CHECK( csv_print( ptc::str_in( arena ), "a", 'b' ) == "a, b.\n" );
+  #endif
+
+  // Global locale, which is honoured as by ptc::print
+  struct grouping_punct: std::numpunct <char>
+   {
+    char do_thousands_sep() const override { return ','; }
+    std::string do_grouping() const override { return "\3"; }
+   };
+  const std::locale global = std::locale::global( std::locale( std::locale::classic(), new grouping_punct ) );
+  CHECK_EQ( csv_print( ptc::mode::str, 1234567 ), "1,234,567.\n" );
+  CHECK_EQ( csv_print( ptc::to( str ), 1234567 ), 11 );
+  CHECK_EQ( str, "1,234,567.\n" );
+  std::locale::global( global );
+  CHECK_EQ( csv_print( ptc::mode::str, 1234567 ), "1234567.\n" );
+
+  // Default configuration and ANSI escape sequences
+  ptc::StaticPrint <ptc::chars<' '>, ptc::chars<>> static_print;
+  CHECK_EQ( static_print( ptc::mode::str, "Testing", "\033[31mcolors" ), "Testing \033[31mcolors\033[0m" );
+  CHECK_EQ( static_print( ptc::mode::str, "", "Empty" ), "Empty " );
+  CHECK_EQ( csv_print( ptc::mode::str, ptc::style::bold, "b" ), "\033[1mb, .\n\033[0m" );
+  CHECK_EQ( csv_print( ptc::mode::str, ptc::style::bold, "b", ptc::end( "" ) ), "\033[1mb, \033[0m" );
+ }
+
+//====================================================
+//     BasicPrint class
+//====================================================
+TEST_CASE( "Testing the BasicPrint class." )
+ {
+  SUBCASE( "Wide streams." )
+   {
+    ptc::WPrint wprint;
+    CHECK( wprint.getSep() == L" " );
+    CHECK( wprint.getEnd() == L"\n" );
+    std::wostringstream wostr;
+    wprint( wostr, L"Wide", "narrow", 123, 2.5, L'c', std::vector <int>{ 1, 2 } );
+    wprint( wostr );
+    CHECK( wostr.str() == L"Wide narrow 123 2.5 c [1, 2]\n\n" );
+    CHECK( wprint( ptc::mode::str, std::wstring( L"a" ), std::wstring_view( L"b" ), std::string( "c" ) ) == L"a b c\n" );
+   }
+
+  SUBCASE( "Transcoding." )
+   {
+    ptc::U16Print u16print;
+    ptc::U32Print u32print;
+    CHECK( u16print( ptc::mode::str, "\xcf\x80", "\xf0\x9f\x98\x80", u"ok" ) == u"\u03c0 \U0001F600 ok\n" );
+    CHECK( u32print( ptc::mode::str, "\xcf\x80", "\xf0\x9f\x98\x80", U"ok" ) == U"\u03c0 \U0001F600 ok\n" );
+    CHECK( u32print( ptc::mode::str, "a\xff" "b", "\xe2\x82", "\xc0\xaf" ) == U"a\uFFFDb \uFFFD\uFFFD \uFFFD\uFFFD\n" );
+    CHECK( u32print( ptc::mode::str, "Long ASCII run, widened in blocks:", 1234567 ) == U"Long ASCII run, widened in blocks: 1234567\n" );
+   }
+
+  SUBCASE( "Setters, call options and ANSI escape sequences." )
+   {
+    ptc::U16Print u16print;
+    u16print.setSep( "\xe2\x86\x92" );
+    u16print.setEnd( u"." );
+    CHECK( u16print.getSep() == u"\u2192" );
+    CHECK( u16print( ptc::mode::str, "a", "b" ) == u"a\u2192b." );
+    CHECK( u16print( ptc::mode::str, "a", "b", ptc::sep( "*" ), ptc::end( "\n" ) ) == u"a*b\n" );
+    CHECK( u16print( ptc::mode::str, ptc::style::red, "a" ) == u"\033[31ma\u2192.\033[0m" );
+    CHECK( u16print( ptc::mode::str, "Testing", u"\033[31mcolors" ) == u"Testing\u2192\033[31mcolors.\033[0m" );
+    u16print.setMaxItems( 2 );
+    CHECK( u16print( ptc::mode::str, std::vector <int>{ 1, 2, 3 } ) == u"[1, 2, ...]." );
+   }
+ }
+
+//====================================================
+//     FixedPrint class
+//====================================================
+TEST_CASE( "Testing the FixedPrint class." )
+ {
+  ptc::FixedPrint <128, ptc::chars<',', ' '>> fixed_print;
+  CHECK_EQ( fixed_print.getSep(), ", " );
+  CHECK_EQ( fixed_print.getEnd(), "\n" );
+  CHECK_EQ( fixed_print.getCapacity(), 128 );
+
+  // Objects which are used inside the guard
+  const std::string str = "string";
+  const std::vector <int> vec = { 1, 2, 3 };
+  const std::map <int, std::string> map = { { 1, "a" }, { 2, "b" } };
+  const std::array <double, 2> arr = { 0.5, 1.25 };
+  const int c_arr[ 2 ] = { 4, 5 };
+  const std::complex <double> cmplx( 1, 2 );
+  const std::pair <int, char> pair( 3, 'x' );
+  fixed_sink sink;
+  char buf[ 256 ];
+  ptc::to_n_result <char*> result{ buf, 0 }, result_2{ buf, 0 };
+  bool complete = false;
+
+  SUBCASE( "No allocations." )
+   {
+     {
+      allocation_guard guard;
+      try
+       {
+        result = fixed_print( ptc::to( buf, sizeof( buf ) ), "Text", str, std::string_view( "view" ), 'c', true, -42, 123456789ull, 2.5f, 0.1, nullptr, cmplx, pair, vec, map, arr, c_arr );
+        result_2 = fixed_print( ptc::to( result.out, sizeof( buf ) - result.size ), ptc::style::red, "red" );
+        complete = fixed_print( sink, "Sink", vec );
+       }
+      catch( const std::bad_alloc& ) {}
+      CHECK_EQ( allocation_guard::failures(), 0 );
+     }
+    CHECK_EQ( std::string_view( buf, result.size ), "Text, string, view, c, 1, -42, 123456789, 2.5, 0.1, nullptr, 1+2j, [3, x], [1, 2, 3], [[1, a], [2, b]], [0.5, 1.25], [4, 5]\n" );
+    CHECK_EQ( std::string_view( result.out, result_2.size ), "\033[31mred, \n\033[0m" );
+    CHECK( complete );
+    CHECK_EQ( std::string_view( sink.content, sink.size ), "Sink, [1, 2, 3]\n" );
+   }
+
+  SUBCASE( "Truncation." )
+   {
+    ptc::FixedPrint <16> small_print;
+    const auto truncated = small_print( ptc::to( buf, sizeof( buf ) ), "0123456789", "abcdef" );
+    CHECK_EQ( std::string_view( buf, truncated.size ), "0123456789 \n" );
+    CHECK_FALSE( small_print( sink, "0123456789", "abcdef" ) );
+   }
+ }
+
+//====================================================
+//     Print setBuffer, getBuffer and commit
+//====================================================
+TEST_CASE( "Testing the Print buffered output mode." )
+ {
+  std::streambuf* coutbuf = std::cout.rdbuf();
+  ptc::savebuf sbuf( coutbuf );
+  std::cout.rdbuf( &sbuf );
+
+  // Lines are kept in the buffer until the commit
+  ptc::print.setBuffer( 1024, std::chrono::seconds( 60 ) );
+  CHECK_EQ( ptc::print.getBuffer(), 1024 );
+  ptc::print( "First", "line." );
+  ptc::print();
+  ptc::print( "Second", "line." );
+  CHECK_EQ( sbuf.str(), "" );
+  ptc::print.commit();
+  CHECK_EQ( sbuf.str(), "First line.\n\nSecond line.\n" );
+
+  // Lines are committed when the threshold is reached
+  ptc::print.setBuffer( 16 );
+  ptc::print( "Third", "line." );
+  CHECK_EQ( sbuf.str(), "First line.\n\nSecond line.\n" );
+  ptc::print( "Fourth", "line." );
+  CHECK_EQ( sbuf.str(), "First line.\n\nSecond line.\nThird line.\nFourth line.\n" );
+
+  // Lines are committed when the buffered mode is disabled
+  ptc::print( "Fifth", "line." );
+  ptc::print.setBuffer( 0 );
+  CHECK_EQ( ptc::print.getBuffer(), 0 );
+  CHECK_EQ( sbuf.str(), "First line.\n\nSecond line.\nThird line.\nFourth line.\nFifth line.\n" );
+
+  // Lines are committed when the deadline expires, also if the thread does not print anymore
+  struct print_access: ptc::Print { using ptc::Print::stream_mutex; };
+  auto committed = [ &sbuf ]( const std::string& expected )
+   {
+    for ( int i = 0; i < 500; ++i )
+     {
+       {
+        std::lock_guard <std::mutex> lock{ print_access::stream_mutex( std::cout ) };
+        if ( sbuf.str() == expected ) return true;
+       }
+      std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+     }
+    return false;
+   };
+  const std::string previous = sbuf.str();
+  ptc::print.setBuffer( 1024, std::chrono::milliseconds( 20 ) );
+  ptc::print( "Sixth", "line." );
+  CHECK( committed( previous + "Sixth line.\n" ) );
+
+  // Disabling the buffered mode commits the buffers of the other threads
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool printed = false, done = false;
+  ptc::print.setBuffer( 1024, std::chrono::seconds( 60 ) );
+  std::thread other( [ & ]()
+   {
+    ptc::print( "Seventh", "line." );
+    std::unique_lock <std::mutex> lock{ mutex };
+    printed = true;
+    cv.notify_one();
+    cv.wait( lock, [ &done ]{ return done; } );
+   } );
+   {
+    std::unique_lock <std::mutex> lock{ mutex };
+    cv.wait( lock, [ &printed ]{ return printed; } );
+   }
+  ptc::print.setBuffer( 0 );
+  CHECK( committed( previous + "Sixth line.\nSeventh line.\n" ) );
+   {
+    std::lock_guard <std::mutex> lock{ mutex };
+    done = true;
+   }
+  cv.notify_one();
+  other.join();
+
+  std::cout.rdbuf( coutbuf );
+ }
+
+//====================================================
+//     AsyncPrint
+//====================================================
+TEST_CASE( "Testing the AsyncPrint class." )
+ {
+  // Block policy
+  SUBCASE( "Block policy." )
+   {
+    std::ostringstream ostr;
+    ptc::AsyncPrint async_print( ostr, 2, ptc::overflow::block );
+    std::string expected;
+    for ( int i = 0; i < 100; ++i ) 
+     {
+      async_print( "Message", i );
+      expected += "Message " + std::to_string( i ) + "\n";
+     }
+    async_print( "Last", "message", ptc::sep( "_" ), ptc::flush );
+    expected += "Last_message\n";
+    async_print.flush();
+    CHECK_EQ( ostr.str(), expected );
+    CHECK_EQ( async_print.getDropped(), 0 );
+   }
+
+  // Drop policy
+  SUBCASE( "Drop policy." )
+   {
+    gate_buf gate;
+    std::ostream os( &gate );
+    ptc::AsyncPrint async_print( os, 2, ptc::overflow::drop );
+    async_print( "m1" );
+    gate.wait_entered();
+    async_print( "m2" );
+    async_print( "m3" );
+    async_print( "m4" );
+    gate.release();
+    async_print.flush();
+    CHECK_EQ( gate.str(), "m1\nm2\nm3\n" );
+    CHECK_EQ( async_print.getDropped(), 1 );
+   }
+
+  // Drop oldest policy
+  SUBCASE( "Drop oldest policy." )
+   {
+    gate_buf gate;
+    std::ostream os( &gate );
+    ptc::AsyncPrint async_print( os, 2, ptc::overflow::drop_oldest );
+    async_print( "m1" );
+    gate.wait_entered();
+    async_print( "m2" );
+    async_print( "m3" );
+    async_print( "m4" );
+    gate.release();
+    async_print.flush();
+    CHECK_EQ( gate.str(), "m1\nm3\nm4\n" );
+    CHECK_EQ( async_print.getDropped(), 1 );
+   }
+
+  // Delivery at shutdown
+  SUBCASE( "Delivery at shutdown." )
+   {
+    std::ostringstream ostr;
+      {
+       ptc::AsyncPrint async_print( ostr );
+       async_print.setSep( "*" );
+       async_print( "Delivered", "at", "shutdown" );
+       async_print( ostr );
+      }
+    CHECK_EQ( ostr.str(), "Delivered*at*shutdown\n\n" );
+   }
+
+  // Printing after join
+  SUBCASE( "Printing after join." )
+   {
+    std::ostringstream ostr;
+    ptc::AsyncPrint async_print( ostr );
+    async_print( "Before" );
+    async_print.join();
+    async_print( "After" );
+    CHECK_EQ( ostr.str(), "Before\nAfter\n" );
+    CHECK_EQ( async_print( ptc::mode::str, "String", "mode" ), "String mode\n" );
+   }
+ }
+
+//====================================================
+//     BinaryLog class
+//====================================================
+TEST_CASE( "Testing the BinaryLog class." )
+ {
+  // Decoding a log
+  SUBCASE( "Decoding a log." )
+   {
+    std::remove( "test_log.bin" );
+    std::string expected;
+     {
+      ptc::Print config;
+      config.setSep( "_" );
+      ptc::BinaryLog log( "test_log.bin", config );
+      for ( int i = 0; i < 100; ++i ) 
+       {
+        log( "Line", i, 0.5, 'c', true );
+        expected += "Line_" + std::to_string( i ) + "_0.5_c_1\n";
+       }
+      log( std::string( "Container" ), std::vector <int>{ 1, 2, 3 }, -7LL, 3u );
+      expected += "Container_[1, 2, 3]_-7_3\n";
+      log();
+      expected += "\n";
+      log( "", "Empty", "first" );
+      expected += "Empty_first_\n";
+      log( ptc::style::red, "Error" );
+      expected += "\033[31mError_\n\033[0m";
+      log.flush();
+      CHECK_EQ( log.getError().value(), 0 );
+      CHECK_EQ( log.getDropped(), 0 );
+     }
+
+    std::ifstream file_stream_i( "test_log.bin", std::ios::binary );
+    std::ostringstream content;
+    CHECK( ptc::decode_log( file_stream_i, content ) );
+    CHECK_EQ( content.str(), expected );
+    file_stream_i.close();
+    std::remove( "test_log.bin" );
+   }
+
+  // Appending to a log
+  SUBCASE( "Appending to a log." )
+   {
+    std::remove( "test_log.bin" );
+    for ( const char* sep: { "_", ", " } )
+     {
+      ptc::Print config;
+      config.setSep( sep );
+      ptc::BinaryLog log( "test_log.bin", config );
+      log( "Run", std::string( sep ), 1 );
+      log( 'c', true );
+     }
+
+    std::ifstream file_stream_i( "test_log.bin", std::ios::binary );
+    std::ostringstream content;
+    CHECK( ptc::decode_log( file_stream_i, content ) );
+    CHECK_EQ( content.str(), "Run___1\nc_1\nRun, , , 1\nc, 1\n" );
+    file_stream_i.close();
+    std::remove( "test_log.bin" );
+
+    // Files which do not contain a binary log are not modified
+    std::ofstream( "test_log.bin" ) << "Text file.";
+    CHECK_THROWS_AS( ptc::BinaryLog( "test_log.bin" ), std::system_error );
+    std::ifstream text_file( "test_log.bin" );
+    std::string text;
+    std::getline( text_file, text );
+    CHECK_EQ( text, "Text file." );
+    text_file.close();
+    std::remove( "test_log.bin" );
+   }
+
+  // Invalid logs
+  SUBCASE( "Invalid logs." )
+   {
+    std::istringstream invalid( "not a log" );
+    std::ostringstream content;
+    CHECK_FALSE( ptc::decode_log( invalid, content ) );
+    CHECK_THROWS_AS( ptc::BinaryLog( "missing_directory/test_log.bin" ), std::system_error );
+
+    // A corrupted boolean byte is decoded as true
+    std::string corrupted( "PTCLOG1\n" );
+    auto append_u32 = [ &corrupted ]( std::uint32_t x ){ corrupted.append( reinterpret_cast <const char*> ( &x ), sizeof( x ) ); };
+    append_u32( 0x01020304 );
+    append_u32( 1 );
+    corrupted += ' ';
+    append_u32( 1 );
+    corrupted += '\n';
+    append_u32( 0xFFFFFFFF );
+    append_u32( 0 );
+    append_u32( 1 );
+    corrupted += static_cast <char> ( ptc::log_type::boolean );
+    append_u32( 0 );
+    corrupted += '\x02';
+    std::istringstream corrupted_log( corrupted );
+    CHECK( ptc::decode_log( corrupted_log, content ) );
+    CHECK_EQ( content.str(), "1\n" );
+
+    // Sizes and identifiers larger than the log are rejected without allocating them
+    std::string huge_size = corrupted.substr( 0, 12 );
+    huge_size.append( "\xF0\xFF\xFF\xFF", 4 );
+    std::istringstream huge_size_log( huge_size );
+    CHECK_FALSE( ptc::decode_log( huge_size_log, content ) );
+    struct unseekable_buf: std::stringbuf
+     {
+      using std::stringbuf::stringbuf;
+      pos_type seekoff( off_type, std::ios_base::seekdir, std::ios_base::openmode ) override { return pos_type( off_type( -1 ) ); }
+     } unseekable( huge_size );
+    std::istream unseekable_log( &unseekable );
+    CHECK_FALSE( ptc::decode_log( unseekable_log, content ) );
+    std::string huge_id = corrupted.substr( 0, 26 );
+    huge_id.append( "\xFF\xFF\xFF\x7F", 4 );
+    huge_id.append( corrupted, 30, 5 );
+    std::istringstream huge_id_log( huge_id );
+    CHECK_FALSE( ptc::decode_log( huge_id_log, content ) );
+   }
+ }
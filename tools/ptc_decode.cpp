@@ -0,0 +1,37 @@
+//====================================================
+//     Headers
+//====================================================
+
+// My headers
+#include "../include/ptc/binary_log.hpp"
+
+// STD headers
+#include <fstream>
+#include <iostream>
+
+//====================================================
+//     main
+//====================================================
+int main( int argc, char** argv )
+ {
+  if ( argc != 2 )
+   {
+    ptc::print( std::cerr, "Usage:", argv[0], "<binary log>" );
+    return 2;
+   }
+
+  std::ifstream in( argv[1], std::ios::binary );
+  if ( ! in )
+   {
+    ptc::print( std::cerr, "Cannot open", argv[1] );
+    return 1;
+   }
+
+  std::ios::sync_with_stdio( false );
+  if ( ! ptc::decode_log( in, std::cout ) )
+   {
+    std::cout.flush();
+    ptc::print( std::cerr, argv[1], "is not a valid or complete binary log." );
+    return 1;
+   }
+ }